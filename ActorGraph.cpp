@@ -14,7 +14,9 @@
 #include <string>
 #include <vector>
 #include <queue>
+#include <climits>
 #include "ActorGraph.hpp"
+#include "UnionFind.hpp"
 
 using namespace std;
 
@@ -67,6 +69,20 @@ public:
   }
 };
 
+/** Comparator class used to binary search an actor's
+  * adjacency list (sorted by release date) for the edges
+  * of a given year.
+  */
+class EdgeYearComp {
+public:
+  bool operator()(ActorEdge* const& edge, int year) const {
+    return edge->movie->date < year;
+  }
+  bool operator()(int year, ActorEdge* const& edge) const {
+    return year < edge->movie->date;
+  }
+};
+
 /* Constructor */
 ActorGraph::ActorGraph(void) {}
 
@@ -120,6 +136,9 @@ bool ActorGraph::loadFromFile(const char* in_filename, bool use_weighted_edges)
   }
   infile.close();
 
+  // Components only depend on the casts, so find them right away
+  buildComponents();
+
   return true;
 }
 
@@ -139,6 +158,7 @@ void ActorGraph::setup (string actor_name, string movie_title, int movie_year) {
   // Add all of the actors to the graph
   if(actorsMap.find(actor_name) == actorsMap.end()) {
     actor = new ActorNode(actor_name);
+    actor->id = actorCount;
     actorsMap[actor_name] = actor;
     ++actorCount; // Update the actor count
   }
@@ -188,6 +208,90 @@ void ActorGraph::buildActorEdges() {
       }
     }
   }
+
+  // Keep a copy of every adjacency list sorted by release date, so
+  // the edges of any range of years are next to each other (the
+  // adjacency lists keep their order, which unwindowed searches use)
+  for (auto& actor : actorsMap) {
+    auto& edges = actor.second->edgesByYear;
+    edges = actor.second->adjacencyList;
+    stable_sort(edges.begin(), edges.end(), [](ActorEdge* lhs, ActorEdge* rhs) {
+      return lhs->movie->date < rhs->movie->date;
+    });
+  }
+}
+
+/** This function handles the delegated task of finding the
+  * edges of an actor that come from movies released within
+  * the current [fromYear, toYear] window. Since the edgesByYear
+  * lists are sorted by date, these are found by binary search.
+  * Without a window, the whole adjacency list is used as is.
+  *
+  * @params: ActorNode* -> the actor whose edges are wanted
+  * @returns: pair of iterators to the first & past the last edge
+  */
+pair<vector<ActorEdge*>::iterator, vector<ActorEdge*>::iterator>
+ActorGraph::edgesInWindow(ActorNode* actor) {
+  // No window: every edge counts, in the order they were built
+  if (fromYear == INT_MIN && toYear == INT_MAX)
+    return make_pair(actor->adjacencyList.begin(), actor->adjacencyList.end());
+
+  auto& edges = actor->edgesByYear;
+  auto first = lower_bound(edges.begin(), edges.end(), fromYear, EdgeYearComp());
+  auto last = upper_bound(first, edges.end(), toYear, EdgeYearComp());
+  return make_pair(first, last);
+}
+
+/** This function handles the delegated task of finding the
+  * connected components of the graph. The movies are added to
+  * a union-find in release order, joining each movie's cast, so
+  * besides the component of every actor we also learn the last
+  * year each component grew (the year it reached its final form).
+  * Two actors in different components can never be connected.
+  *
+  * @params: none
+  * @returns: void
+  */
+void ActorGraph::buildComponents() {
+  // The actors' ids index the union-find
+  std::vector<ActorNode*> actors(actorsMap.size());
+  for (auto& actor : actorsMap)
+    actors[actor.second->id] = actor.second;
+
+  UnionFind sets((int) actors.size());
+
+  for (auto& year : movieByYear) {
+    for (auto& movie : year.second) {
+      int first = -1;
+
+      for (auto& actor : movie->cast) {
+        sets.touch(actor.second->id, year.first);
+
+        if (first == -1)
+          first = actor.second->id;
+        else
+          sets.merge(first, actor.second->id, year.first);
+      }
+    }
+  }
+
+  // Number the components by their representative
+  std::vector<int> label(actors.size(), -1);
+  componentMembers.clear();
+  componentYear.clear();
+
+  for (size_t i = 0; i < actors.size(); ++i) {
+    int root = sets.find((int) i);
+
+    if (label[root] == -1) {
+      label[root] = (int) componentMembers.size();
+      componentMembers.emplace_back();
+      componentYear.push_back(sets.getYear(root));
+    }
+
+    actors[i]->component = label[root];
+    componentMembers[label[root]].push_back(actors[i]);
+  }
 }
 
 /** This function handles the delegated task of running a BFS
@@ -198,11 +302,17 @@ void ActorGraph::buildActorEdges() {
   * The BFS traversal guantees that it will be the shortest path to
   * the specific ActorNode.
   * 
-  * @params: ActorNode* -> to the Actor to perform BFS on.
+  * Only movies released from fromYear to toYear (inclusive)
+  * are used, the whole graph if no years are given.
+  *
+  * @params: ActorNode* -> to the Actor to perform BFS on,
+  *          int, int -> first & last year of the movies to use
   * @returns: void
   */
-void ActorGraph::BFS(ActorNode* start) {
-  resetActorFields();
+void ActorGraph::BFS(ActorNode* start, int fromYear, int toYear) {
+  resetActorFields(start->component);
+  this->fromYear = fromYear;
+  this->toYear = toYear;
 
   // Initialize the queue
   std::queue<ActorNode*> toExplore;
@@ -216,8 +326,9 @@ void ActorGraph::BFS(ActorNode* start) {
 
     // Add all the dequeued actor's adjacent ActorNode's(neighbors) 
     // to the queue.
-    for(auto& edge : curr->adjacencyList) {
-      ActorNode* neighbor = edge->otherActor;
+    auto edges = edgesInWindow(curr);
+    for(auto edge = edges.first; edge != edges.second; ++edge) {
+      ActorNode* neighbor = (*edge)->otherActor;
 
       // If the actor hasn't already been visited, update it
       if (!neighbor->visited) {
@@ -238,11 +349,16 @@ void ActorGraph::BFS(ActorNode* start) {
   * other node, a pointer to the previous node is added
   * to each node during the traversal.
   *
-  * @params: start - ActorNode* - pointer to starting node
+  * Like BFS, only movies from fromYear to toYear are used.
+  *
+  * @params: start - ActorNode* - pointer to starting node,
+  *          fromYear, toYear - first & last year of the movies to use
   * @return: void
   */
-void ActorGraph::Dijkstra(ActorNode* start) {
-  resetActorFields();
+void ActorGraph::Dijkstra(ActorNode* start, int fromYear, int toYear) {
+  resetActorFields(start->component);
+  this->fromYear = fromYear;
+  this->toYear = toYear;
 
   std::priority_queue<ActorNode*, vector<ActorNode*>, ActorComp> pq;
   auto curr = start;
@@ -260,11 +376,12 @@ void ActorGraph::Dijkstra(ActorNode* start) {
     if (!curr->visited) {
       curr->visited = true;
 
-      for(auto& edge : curr->adjacencyList) {
-        auto otherActor = edge->otherActor;
+      auto edges = edgesInWindow(curr);
+      for(auto edge = edges.first; edge != edges.second; ++edge) {
+        auto otherActor = (*edge)->otherActor;
 
-        if (otherActor->dist == -1 || (curr->dist + edge->weight) < otherActor->dist) {
-          otherActor->dist = curr->dist + edge->weight;
+        if (otherActor->dist == -1 || (curr->dist + (*edge)->weight) < otherActor->dist) {
+          otherActor->dist = curr->dist + (*edge)->weight;
           otherActor->prev = curr;
         }
         pq.push(otherActor);
@@ -287,30 +404,126 @@ void ActorGraph::resetActorFields() {
   }
 }
 
+/** Same as above, but only for the actors of one component,
+  * which are the only ones a search from inside it can reach.
+  *
+  * @params: component - index of the component to reset
+  */
+void ActorGraph::resetActorFields(int component) {
+  for (auto& actor : componentMembers[component]) {
+    actor->dist = -1;
+    actor->prev = 0;
+    actor->visited = false;
+  }
+}
+
+/** This function handles the delegated task of finding the
+  * earliest year two actors become connected, using only movies
+  * released from fromYear on. Being connected by movies up to a
+  * year only gets more likely as the year grows, so the year is
+  * binary searched with a windowed BFS per probe. Unless the window
+  * leaves out early movies, the search never goes past the year the
+  * actors' component reached its final form.
+  *
+  * @params: 2 ActorNode pointers: start & end,
+  *          int, int -> first & last year of the movies to use
+  * @returns: the earliest year, or -1 if they never get connected
+  */
+int ActorGraph::connectedYear(ActorNode* start, ActorNode* end, int fromYear, int toYear) {
+  if (start->component != end->component)
+    return -1;
+
+  // With every movie from the start, they are connected once their
+  // component is complete (later windows may need later movies)
+  if (movieByYear.empty() || fromYear <= movieByYear.begin()->first)
+    toYear = min(toYear, componentYear[start->component]);
+
+  // The release years that could be the answer
+  std::vector<int> years;
+  for (auto year = movieByYear.lower_bound(fromYear);
+       year != movieByYear.end() && year->first <= toYear; ++year)
+    years.push_back(year->first);
+
+  int found = -1;
+  int low = 0, high = (int) years.size() - 1;
+
+  while (low <= high) {
+    int mid = low + (high - low) / 2;
+    BFS(start, fromYear, years[mid]);
+
+    if (end->visited) {
+      found = years[mid];
+      high = mid - 1;
+    }
+    else
+      low = mid + 1;
+  }
+
+  return found;
+}
+
+/** Same as connectedYear(), but the casts of the movies are joined
+  * year by year in a UnionFind (starting from one set per actor)
+  * until both actors end up in the same set.
+  *
+  * @params: 2 ActorNode pointers: start & end,
+  *          int, int -> first & last year of the movies to use
+  * @returns: the earliest year, or -1 if they never get connected
+  */
+int ActorGraph::unionFindYear(ActorNode* start, ActorNode* end, int fromYear, int toYear) {
+  if (start->component != end->component)
+    return -1;
+
+  UnionFind sets(actorCount);
+
+  // Same bound as connectedYear()
+  if (movieByYear.empty() || fromYear <= movieByYear.begin()->first)
+    toYear = min(toYear, componentYear[start->component]);
+
+  for (auto year = movieByYear.lower_bound(fromYear); year != movieByYear.end(); ++year) {
+    if (year->first > toYear)
+      break;
+
+    // Join each movie's cast into one set
+    for (auto& movie : year->second) {
+      ActorNode* first = movie->cast.begin()->second;
+
+      for (auto& actor : movie->cast)
+        sets.merge(first->id, actor.second->id, year->first);
+    }
+
+    // Now that all the movies of the year are in, check both actors
+    if (sets.find(start->id) == sets.find(end->id))
+      return year->first;
+  }
+
+  return -1;
+}
+
 /** This function handles the task of printing the paths from one
-  * actor to the other to the provided output file. This method
-  * uses a recursive approach to back track the ending node to
-  * the starting node of the path.
+  * actor to the other to the provided output. This method follows
+  * the prev pointers back from the ending node to the starting
+  * node of the path, then prints the actors in order.
   *
-  * @params:  2 ActorNodes (pointers) & ofstream (output file)
+  * @params:  2 ActorNodes (pointers) & ResultWriter (output file)
   * @returns: void
   */
-void ActorGraph::exportResults(ActorNode* actor1, ActorNode* actor2, ofstream& out) {
-  // Base case: Stop when the actor's previous pointer is NULL
-  if (actor2->prev == NULL) {
-    out << "(" << actor2->actorName << ")";
-    return;
-  }
-  // Rescursive call: Call method with the first actor & the second's previous actor
-  else 
-    exportResults(actor1, actor2->prev, out);
+void ActorGraph::exportResults(ActorNode* actor1, ActorNode* actor2, ResultWriter& out) {
+  // Walk back from the second actor until the first one is reached
+  std::vector<ActorNode*> path(1, actor2);
+  while (path.back() != actor1 && path.back()->prev != NULL)
+    path.push_back(path.back()->prev);
+
+  out << "(" << path.back()->actorName << ")";
 
-  // Calls method to find any movie relating to both actors
-  Movie* movie = findCommonMovie(actor2, actor2->prev);
+  for (size_t i = path.size() - 1; i > 0; --i) {
+    // Calls method to find any movie relating to both actors
+    Movie* movie = findCommonMovie(path[i - 1], path[i]);
 
-  // Print the 2nd actor's name & movie both actors starred on
-  out << "--[" << movie->name << "#@" << movie->date << "]-->"
-      << "(" << actor2->actorName << ")";
+    // Print the next actor's name & movie both actors starred on
+    out << "--[" << movie->name << "#@" << movie->date << "]-->"
+        << "(" << path[i - 1]->actorName << ")";
+  }
 }
 
 /** This method handles the delegated task of finding a common movie
@@ -346,8 +559,12 @@ Movie* ActorGraph::findCommonMovie(ActorNode* actor, ActorNode* otherActor) {
           movieList2.begin(), movieList2.end(), std::back_inserter(commonMovies));
 
   // So now we take the vector & prioritize the movies based on date, highest first.
-  for(auto& movie : commonMovies)
-    pq.push(movies[movie]);
+  // Only movies within the window of the last search can be used
+  for(auto& movie : commonMovies) {
+    Movie* common = movies[movie];
+    if (common->date >= fromYear && common->date <= toYear)
+      pq.push(common);
+  }
 
   // We now return the top prioritized movie
   return pq.top();
@@ -360,4 +577,12 @@ unordered_map<string, ActorNode*> ActorGraph::getActorsMap() {
 
 map<int, std::vector<Movie*>> ActorGraph::getMovieByYear() {
   return movieByYear;
+}
+
+int ActorGraph::getComponentYear(int component) {
+  return componentYear[component];
+}
+
+int ActorGraph::getComponentCount() {
+  return (int) componentMembers.size();
 }
\ No newline at end of file
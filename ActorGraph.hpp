@@ -18,8 +18,10 @@
 #include <map>
 #include <algorithm>
 #include <iterator>
+#include <climits>
 #include "ActorNode.hpp"
 #include "Movie.hpp"
+#include "ResultWriter.hpp"
 using namespace std;
 
 class ActorComp;
@@ -36,6 +38,19 @@ protected:
   // This map stores all the movies based on the year they were released
   std::map<int, std::vector<Movie*>> movieByYear;
 
+  // The actors in each connected component
+  std::vector<std::vector<ActorNode*>> componentMembers;
+
+  // The year each component reached its final form
+  std::vector<int> componentYear;
+
+  // Years of the movies used by the last BFS/Dijkstra search
+  int fromYear = INT_MIN;
+  int toYear = INT_MAX;
+
+  std::pair<std::vector<ActorEdge*>::iterator, std::vector<ActorEdge*>::iterator>
+  edgesInWindow(ActorNode* actor);
+
 public:
   /* Instance Variables */
   int actorCount = 0;
@@ -59,20 +74,32 @@ public:
   void setup (string actor_name, string movie_title, int movie_year);
 
   void buildActorEdges();
+
+  void buildComponents();
   
-  void BFS(ActorNode* start);
+  void BFS(ActorNode* start, int fromYear = INT_MIN, int toYear = INT_MAX);
+
+  void Dijkstra(ActorNode* start, int fromYear = INT_MIN, int toYear = INT_MAX);
 
-  void Dijkstra(ActorNode* start);
+  int connectedYear(ActorNode* start, ActorNode* end,
+                    int fromYear = INT_MIN, int toYear = INT_MAX);
+
+  int unionFindYear(ActorNode* start, ActorNode* end,
+                    int fromYear = INT_MIN, int toYear = INT_MAX);
 
   void resetActorFields();
 
-  void exportResults(ActorNode* start, ActorNode* end, ofstream& out);
+  void resetActorFields(int component);
+
+  void exportResults(ActorNode* start, ActorNode* end, ResultWriter& out);
 
   Movie* findCommonMovie(ActorNode* actor1, ActorNode* actor2);
 
   /* Getters */
   unordered_map<string, ActorNode*> getActorsMap();
   map<int, std::vector<Movie*>> getMovieByYear();
+  int getComponentYear(int component);
+  int getComponentCount();
 };
 
 
@@ -25,10 +25,13 @@ public:
   bool visited; // Used for Dijkstra's algorithm search.
   int dist;   // Used to measure distance during Dijkstra's algorithm
   ActorNode* prev;  // Used when traversing a path from one actor to another.
-  int rank;
+  int component;  // Connected component the actor ends up in
+  int id;         // Index of the actor, in the order actors were read
 
   // This holds all the ActorEdges that connect him to other ActorNodes.
   std::vector<ActorEdge*> adjacencyList;
+  // The same edges sorted by release date, for windowed searches
+  std::vector<ActorEdge*> edgesByYear;
   // This Vector holds all the movies the actor has starred in
   std::vector<std::string> movieList;
  
@@ -36,7 +39,8 @@ public:
 	ActorNode (std::string name) : actorName(name) {
 		visited = false;
     dist = -1;
-    rank = 0;
+    component = -1;
+    id = -1;
 	}
 };
 
@@ -0,0 +1,467 @@
+/*
+ * ContractionHierarchy.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * Implementation of the contraction hierarchy: node
+ * ordering, witness searches & shortcuts, the file
+ * format & the bidirectional upward query.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include "ContractionHierarchy.hpp"
+
+using namespace std;
+
+static const uint32_t NONE = PackedGraph::NO_ACTOR;
+
+// Witness searches give up after settling this many actors (a
+// missed witness only costs an unneeded shortcut)
+static const uint32_t WITNESS_SETTLED = 64;
+
+// Identifies the file format
+static const uint64_t FILE_MAGIC = 0x3230484342766b4bULL;  // "KkvBCH02"
+
+// Contraction stops once the cheapest node needs more than this
+// many shortcuts per arc it removes
+static const int CORE_GROWTH = 2;
+
+const uint32_t ContractionHierarchy::CORE_DEGREE;
+
+/** An arc of the graph while it is being contracted */
+struct Arc {
+  uint32_t to;
+  int weight;
+  uint32_t middle;  // skipped node, NONE for an original arc
+};
+
+/* Constructor */
+ContractionHierarchy::ContractionHierarchy(const PackedGraph& graph) : graph(graph) {}
+
+/** Hashes the graph's edges & movie years (which set every arc
+  * weight) so a saved hierarchy can be checked against the graph
+  * it is loaded for (FNV-1a).
+  */
+uint64_t ContractionHierarchy::computeFingerprint() const {
+  uint64_t hash = 1469598103934665603ULL;
+  auto mix = [&hash](uint64_t value) {
+    hash ^= value;
+    hash *= 1099511628211ULL;
+  };
+
+  mix(graph.getActorCount());
+  mix(graph.getEdgeCount());
+  for (uint32_t actor = 0; actor < graph.getActorCount(); ++actor) {
+    mix(graph.edgesEnd(actor));
+    for (uint32_t edge = graph.edgesBegin(actor); edge < graph.edgesEnd(actor); ++edge)
+      mix(((uint64_t) graph.edgeTarget(edge) << 32) | graph.edgeMovie(edge));
+  }
+
+  mix(graph.getMovieCount());
+  for (uint32_t movie = 0; movie < graph.getMovieCount(); ++movie)
+    mix((uint64_t) (int64_t) graph.movieYear(movie));
+  return hash;
+}
+
+void ContractionHierarchy::build() {
+  uint32_t actorCount = graph.getActorCount();
+  uint32_t nodeCount = actorCount + graph.getMovieCount();
+  vector<vector<Arc>> arcs(nodeCount);
+
+  // Actor a & movie m are connected by an arc weighing as much as a
+  // step through m, so a step actor-movie-actor costs twice its weight
+  vector<uint32_t> indexTo(nodeCount, NONE);
+  for (uint32_t actor = 0; actor < actorCount; ++actor) {
+    for (uint32_t edge = graph.edgesBegin(actor); edge < graph.edgesEnd(actor); ++edge) {
+      uint32_t movie = actorCount + graph.edgeMovie(edge);
+      if (indexTo[movie] == actor)
+        continue;
+      indexTo[movie] = actor;
+
+      Arc arc = { movie, graph.edgeWeight(edge), NONE };
+      arcs[actor].push_back(arc);
+      arc.to = actor;
+      arcs[movie].push_back(arc);
+    }
+  }
+  fill(indexTo.begin(), indexTo.end(), NONE);
+
+  vector<bool> contracted(nodeCount, false);
+  vector<uint32_t> deletedNeighbors(nodeCount, 0);
+
+  // Scratch space for the witness checks
+  vector<int> weightTo(nodeCount, -1);
+  vector<int> witnessDist(nodeCount, -1);
+  vector<uint32_t> witnessTouched;
+
+  // Drops the arcs to contracted actors from a list
+  auto compact = [&](uint32_t actor) {
+    auto& list = arcs[actor];
+    list.erase(remove_if(list.begin(), list.end(), [&](const Arc& arc) {
+      return contracted[arc.to];
+    }), list.end());
+  };
+
+  // Bounded Dijkstra from source avoiding skip, filling witnessDist
+  auto witnessSearch = [&](uint32_t source, uint32_t skip, int bound) {
+    typedef pair<int, uint32_t> Entry;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> pq;
+    uint32_t settled = 0;
+
+    witnessDist[source] = 0;
+    witnessTouched.push_back(source);
+    pq.push(Entry(0, source));
+
+    while (!pq.empty() && settled < WITNESS_SETTLED) {
+      Entry top = pq.top();
+      pq.pop();
+
+      if (top.first != witnessDist[top.second])
+        continue;
+      if (top.first > bound)
+        break;
+      ++settled;
+
+      for (auto& arc : arcs[top.second]) {
+        if (contracted[arc.to] || arc.to == skip)
+          continue;
+
+        int newDist = top.first + arc.weight;
+        if (newDist > bound)
+          continue;
+
+        if (witnessDist[arc.to] == -1 || newDist < witnessDist[arc.to]) {
+          if (witnessDist[arc.to] == -1)
+            witnessTouched.push_back(arc.to);
+          witnessDist[arc.to] = newDist;
+          pq.push(Entry(newDist, arc.to));
+        }
+      }
+    }
+  };
+
+  // Finds the shortcuts contracting v needs: for every two of its
+  // neighbors u & x, the path u-v-x needs a shortcut unless a direct
+  // arc or a short witness search finds a path at least as short.
+  // Only counts them when simulating, adds them otherwise.
+  auto contract = [&](uint32_t v, bool simulate) {
+    compact(v);
+    vector<Arc> around = arcs[v];
+    uint32_t shortcuts = 0;
+
+    for (size_t i = 0; i < around.size(); ++i) {
+      uint32_t u = around[i].to;
+      int maxNeeded = 0;
+
+      compact(u);
+      for (size_t j = 0; j < arcs[u].size(); ++j) {
+        weightTo[arcs[u][j].to] = arcs[u][j].weight;
+        indexTo[arcs[u][j].to] = (uint32_t) j;
+      }
+
+      // Pairs without a direct arc that is short enough
+      vector<size_t> uncovered;
+      for (size_t k = i + 1; k < around.size(); ++k) {
+        int needed = around[i].weight + around[k].weight;
+        int direct = weightTo[around[k].to];
+
+        if (direct == -1 || direct > needed) {
+          uncovered.push_back(k);
+          maxNeeded = max(maxNeeded, needed);
+        }
+      }
+
+      if (!uncovered.empty())
+        witnessSearch(u, v, maxNeeded);
+
+      for (auto k : uncovered) {
+        uint32_t x = around[k].to;
+        int needed = around[i].weight + around[k].weight;
+
+        if (witnessDist[x] != -1 && witnessDist[x] <= needed)
+          continue;
+
+        ++shortcuts;
+        if (simulate)
+          continue;
+
+        Arc shortcut = { x, needed, v };
+        if (indexTo[x] != NONE)
+          arcs[u][indexTo[x]] = shortcut;
+        else
+          arcs[u].push_back(shortcut);
+
+        // Same arc from the other side
+        shortcut.to = u;
+        auto existing = find_if(arcs[x].begin(), arcs[x].end(), [u](const Arc& arc) {
+          return arc.to == u;
+        });
+        if (existing != arcs[x].end())
+          *existing = shortcut;
+        else
+          arcs[x].push_back(shortcut);
+      }
+
+      for (auto actor : witnessTouched)
+        witnessDist[actor] = -1;
+      witnessTouched.clear();
+
+      for (auto& arc : arcs[u]) {
+        weightTo[arc.to] = -1;
+        indexTo[arc.to] = NONE;
+      }
+    }
+
+    return shortcuts;
+  };
+
+  typedef pair<int, uint32_t> Entry;
+  priority_queue<Entry, vector<Entry>, greater<Entry>> order;
+  for (uint32_t node = 0; node < nodeCount; ++node)
+    order.push(Entry((int) arcs[node].size(), node));
+
+  while (!order.empty()) {
+    uint32_t v = order.top().second;
+    order.pop();
+
+    compact(v);
+    // Highly connected nodes stay in the core
+    if (arcs[v].size() > CORE_DEGREE)
+      continue;
+
+    // Cheap nodes first: few shortcuts per removed arc, & not too many
+    // neighbors already contracted (keeps the hierarchy balanced)
+    int shortcuts = (int) contract(v, true);
+    int degree = (int) arcs[v].size();
+    int current = shortcuts - degree + (int) deletedNeighbors[v];
+
+    // Lazy updates: only contract if it is still the cheapest
+    if (!order.empty() && current > order.top().first) {
+      order.push(Entry(current, v));
+      continue;
+    }
+
+    // Once even the cheapest node adds many more arcs than it removes,
+    // contracting further only makes queries slower: the rest is core
+    if (shortcuts > CORE_GROWTH * degree)
+      break;
+
+    contract(v, false);
+    contracted[v] = true;
+    for (auto& arc : arcs[v])
+      ++deletedNeighbors[arc.to];
+  }
+
+  // Upward arcs: a contracted node keeps the arcs it had when it
+  // was contracted (all to later nodes), a core node keeps its arcs
+  // to the rest of the core
+  upOffsets.assign(nodeCount + 1, 0);
+  upTargets.clear();
+  upWeights.clear();
+  upMiddles.clear();
+
+  for (uint32_t node = 0; node < nodeCount; ++node) {
+    if (!contracted[node])
+      compact(node);
+
+    auto& list = arcs[node];
+    sort(list.begin(), list.end(), [](const Arc& lhs, const Arc& rhs) {
+      return lhs.to < rhs.to;
+    });
+
+    for (auto& arc : list) {
+      upTargets.push_back(arc.to);
+      upWeights.push_back(arc.weight);
+      upMiddles.push_back(arc.middle);
+    }
+    upOffsets[node + 1] = (uint32_t) upTargets.size();
+
+    vector<Arc>().swap(list);
+  }
+
+  fingerprint = computeFingerprint();
+}
+
+bool ContractionHierarchy::save(const string& filename) const {
+  ofstream out(filename, ios::binary);
+  if (!out)
+    return false;
+
+  uint64_t header[4] = { FILE_MAGIC, fingerprint, upOffsets.size(), upTargets.size() };
+  out.write((const char*) header, sizeof(header));
+  out.write((const char*) upOffsets.data(), upOffsets.size() * sizeof(uint32_t));
+  out.write((const char*) upTargets.data(), upTargets.size() * sizeof(uint32_t));
+  out.write((const char*) upWeights.data(), upWeights.size() * sizeof(int));
+  out.write((const char*) upMiddles.data(), upMiddles.size() * sizeof(uint32_t));
+
+  return (bool) out;
+}
+
+bool ContractionHierarchy::load(const string& filename) {
+  ifstream in(filename, ios::binary);
+  if (!in)
+    return false;
+
+  uint64_t header[4];
+  if (!in.read((char*) header, sizeof(header)))
+    return false;
+
+  // Reject files of another format or built for another graph
+  if (header[0] != FILE_MAGIC || header[2] != nodeCount() + 1 ||
+      header[1] != computeFingerprint())
+    return false;
+
+  upOffsets.resize(header[2]);
+  upTargets.resize(header[3]);
+  upWeights.resize(header[3]);
+  upMiddles.resize(header[3]);
+
+  in.read((char*) upOffsets.data(), upOffsets.size() * sizeof(uint32_t));
+  in.read((char*) upTargets.data(), upTargets.size() * sizeof(uint32_t));
+  in.read((char*) upWeights.data(), upWeights.size() * sizeof(int));
+  in.read((char*) upMiddles.data(), upMiddles.size() * sizeof(uint32_t));
+
+  fingerprint = header[1];
+  return (bool) in;
+}
+
+/** Finds the upward arc of from that leads to to.
+  *
+  * @returns: the arc's index, NONE if there is none
+  */
+uint32_t ContractionHierarchy::findArc(uint32_t from, uint32_t to) const {
+  auto first = upTargets.begin() + upOffsets[from];
+  auto last = upTargets.begin() + upOffsets[from + 1];
+  auto it = lower_bound(first, last, to);
+
+  return (it != last && *it == to) ? (uint32_t) (it - upTargets.begin()) : NONE;
+}
+
+/** Expands an arc into original ones, appending the nodes after
+  * from (up to & including to). A shortcut from u to x skipping v
+  * is stored at v as the arcs v-u & v-x.
+  */
+void ContractionHierarchy::unpack(uint32_t from, uint32_t to, uint32_t arc,
+                                  vector<uint32_t>& nodes) const {
+  uint32_t middle = upMiddles[arc];
+
+  if (middle == NONE) {
+    nodes.push_back(to);
+    return;
+  }
+
+  unpack(from, middle, findArc(middle, from), nodes);
+  unpack(middle, to, findArc(middle, to), nodes);
+}
+
+/** Sets up the query state the first time & clears what the
+  * last query touched afterwards.
+  */
+void ContractionHierarchy::prepareQuery() {
+  for (int side = 0; side < 2; ++side) {
+    if (dist[side].size() != nodeCount()) {
+      dist[side].assign(nodeCount(), -1);
+      parent[side].assign(nodeCount(), NONE);
+      parentArc[side].assign(nodeCount(), NONE);
+    }
+
+    for (auto actor : touched[side]) {
+      dist[side][actor] = -1;
+      parent[side][actor] = NONE;
+      parentArc[side][actor] = NONE;
+    }
+    touched[side].clear();
+  }
+}
+
+int ContractionHierarchy::query(uint32_t start, uint32_t end, vector<uint32_t>& path,
+                                vector<uint32_t>& movies) {
+  path.clear();
+  movies.clear();
+  prepareQuery();
+
+  typedef pair<int, uint32_t> Entry;
+  priority_queue<Entry, vector<Entry>, greater<Entry>> pq[2];
+
+  uint32_t source[2] = { start, end };
+  for (int side = 0; side < 2; ++side) {
+    dist[side][source[side]] = 0;
+    touched[side].push_back(source[side]);
+    pq[side].push(Entry(0, source[side]));
+  }
+
+  int best = -1;
+  uint32_t meet = NONE;
+
+  // Each side keeps going until its closest actor is no better than
+  // the best meeting found so far
+  while (true) {
+    bool open[2];
+    for (int side = 0; side < 2; ++side)
+      open[side] = !pq[side].empty() && (best == -1 || pq[side].top().first < best);
+
+    if (!open[0] && !open[1])
+      break;
+
+    int side = (open[0] && (!open[1] || pq[0].top().first <= pq[1].top().first)) ? 0 : 1;
+    Entry top = pq[side].top();
+    pq[side].pop();
+
+    uint32_t curr = top.second;
+    if (top.first != dist[side][curr])
+      continue;
+
+    int other = dist[1 - side][curr];
+    if (other != -1 && (best == -1 || top.first + other < best)) {
+      best = top.first + other;
+      meet = curr;
+    }
+
+    for (uint32_t arc = upOffsets[curr]; arc < upOffsets[curr + 1]; ++arc) {
+      uint32_t next = upTargets[arc];
+      int newDist = top.first + upWeights[arc];
+
+      if (dist[side][next] == -1 || newDist < dist[side][next]) {
+        if (dist[side][next] == -1)
+          touched[side].push_back(next);
+        dist[side][next] = newDist;
+        parent[side][next] = curr;
+        parentArc[side][next] = arc;
+        pq[side].push(Entry(newDist, next));
+      }
+    }
+  }
+
+  if (meet == NONE)
+    return -1;
+
+  // Forward half, walked back from the meeting node
+  vector<uint32_t> hops;
+  for (uint32_t curr = meet; curr != start; curr = parent[0][curr])
+    hops.push_back(curr);
+
+  vector<uint32_t> nodes(1, start);
+  uint32_t from = start;
+  for (auto it = hops.rbegin(); it != hops.rend(); ++it) {
+    unpack(from, *it, parentArc[0][*it], nodes);
+    from = *it;
+  }
+
+  // Backward half, from the meeting node down to end
+  for (uint32_t curr = meet; curr != end; curr = parent[1][curr])
+    unpack(curr, parent[1][curr], parentArc[1][curr], nodes);
+
+  // Nodes alternate between actors & the movies linking them. Any
+  // movie of the same year is as short, so the one printed is the
+  // one findCommonMovie picks, like the other searches
+  for (size_t i = 0; i < nodes.size(); i += 2)
+    path.push_back(nodes[i]);
+  for (size_t i = 1; i < path.size(); ++i)
+    movies.push_back(graph.findCommonMovie(path[i - 1], path[i]));
+
+  // Every step was counted on both of its arcs
+  return best / 2;
+}
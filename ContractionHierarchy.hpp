@@ -0,0 +1,104 @@
+/*
+ * ContractionHierarchy.hpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This file defines a contraction hierarchy over the
+ * weighted actor graph (weight = 1 + (2015 - year)) used
+ * to answer weighted queries without a full Dijkstra.
+ *
+ * The hierarchy is built over actors & movies as nodes,
+ * with an arc between a movie & each of its cast members
+ * weighing as much as a step through that movie. Every
+ * movie is then a star rather than a clique of its cast,
+ * which keeps the number of arcs (& shortcuts) down.
+ *
+ * Nodes are contracted one at a time, least important
+ * first. Contracting a node removes it from the graph &
+ * adds a shortcut between two of its neighbors whenever
+ * the path through it was their only shortest connection.
+ * Each shortcut remembers the node it skips, so any path
+ * can be expanded back to actors & the movies between
+ * them. Highly connected nodes are left uncontracted in a
+ * "core", since contracting them would add more shortcuts
+ * than it saves.
+ *
+ * A query searches from both actors, only moving to more
+ * important nodes (or within the core), & takes the best
+ * node where both searches meet.
+ */
+
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PackedGraph.hpp"
+
+class ContractionHierarchy {
+protected:
+  const PackedGraph& graph;
+
+  // Identifies the graph the hierarchy was built for
+  uint64_t fingerprint = 0;
+
+  // Nodes are the actors (by ID) followed by the movies (ID + actor
+  // count). Node i's upward arcs are [upOffsets[i], upOffsets[i + 1]),
+  // sorted by target so they can be binary searched
+  std::vector<uint32_t> upOffsets;
+  std::vector<uint32_t> upTargets;
+  std::vector<int> upWeights;
+  // The node a shortcut skips, NO_ACTOR for an original arc
+  std::vector<uint32_t> upMiddles;
+
+  /* Query state, indexed by node */
+  std::vector<int> dist[2];
+  std::vector<uint32_t> parent[2];      // previous actor
+  std::vector<uint32_t> parentArc[2];   // arc used to get here
+  std::vector<uint32_t> touched[2];
+
+  uint64_t computeFingerprint() const;
+  uint32_t findArc(uint32_t from, uint32_t to) const;
+  void unpack(uint32_t from, uint32_t to, uint32_t arc,
+              std::vector<uint32_t>& nodes) const;
+  void prepareQuery();
+  uint32_t nodeCount() const { return graph.getActorCount() + graph.getMovieCount(); }
+
+public:
+  // Nodes with more neighbors than this are left in the core
+  static const uint32_t CORE_DEGREE = 256;
+
+  /* Constructor */
+  ContractionHierarchy(const PackedGraph& graph);
+
+  /** Contracts the graph & builds the upward arcs. */
+  void build();
+
+  /** Saves the hierarchy to a binary file.
+    *
+    * @returns: true if the file was written
+    */
+  bool save(const std::string& filename) const;
+
+  /** Loads a hierarchy saved by save(), rejecting it if it was
+    * built for a different graph.
+    *
+    * @returns: true if the file was loaded
+    */
+  bool load(const std::string& filename);
+
+  /** Finds a shortest weighted path between two actors.
+    *
+    * @params: 2 actor IDs, path - filled with the actors from start
+    *          to end, movies - filled with the movie printed for every step
+    * @returns: the weighted length, -1 if there is no path
+    */
+  int query(uint32_t start, uint32_t end, std::vector<uint32_t>& path,
+            std::vector<uint32_t>& movies);
+
+  /* Getters */
+  uint32_t getArcCount() const { return (uint32_t) upTargets.size(); }
+};
+
+#endif // CONTRACTIONHIERARCHY_HPP
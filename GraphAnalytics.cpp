@@ -0,0 +1,214 @@
+/*
+ * GraphAnalytics.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * Implementation of the bit-parallel multi-source BFS
+ * & the statistics gathered from it.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "GraphAnalytics.hpp"
+
+using namespace std;
+
+// Number of sources sharing one BFS (one bit each)
+static const size_t BATCH = 64;
+
+/* Constructor */
+GraphAnalytics::GraphAnalytics(const PackedGraph& graph) : graph(graph) {
+  uint32_t actorCount = graph.getActorCount();
+  neighborOffsets.assign(actorCount + 1, 0);
+
+  // Actors sharing several movies only need to be visited once
+  vector<uint32_t> list;
+  for (uint32_t actor = 0; actor < actorCount; ++actor) {
+    list.clear();
+    for (uint32_t edge = graph.edgesBegin(actor); edge < graph.edgesEnd(actor); ++edge)
+      list.push_back(graph.edgeTarget(edge));
+
+    sort(list.begin(), list.end());
+    list.erase(unique(list.begin(), list.end()), list.end());
+
+    neighbors.insert(neighbors.end(), list.begin(), list.end());
+    neighborOffsets[actor + 1] = (uint32_t) neighbors.size();
+  }
+}
+
+/** Copies the component labels computed when the graph was
+  * loaded & counts the actors in each component.
+  */
+void GraphAnalytics::computeComponents() {
+  uint32_t actorCount = graph.getActorCount();
+  component.resize(actorCount);
+  componentSizes.assign(graph.getComponentCount(), 0);
+
+  for (uint32_t actor = 0; actor < actorCount; ++actor) {
+    component[actor] = graph.getComponent(actor);
+    ++componentSizes[component[actor]];
+  }
+}
+
+vector<uint32_t> GraphAnalytics::pickSources(uint32_t sampleSize, uint64_t seed) const {
+  vector<uint32_t> picked(graph.getActorCount());
+  for (uint32_t actor = 0; actor < picked.size(); ++actor)
+    picked[actor] = actor;
+
+  if (sampleSize > 0 && sampleSize < picked.size()) {
+    mt19937_64 rng(seed);
+    shuffle(picked.begin(), picked.end(), rng);
+    picked.resize(sampleSize);
+  }
+
+  // Sources of one batch should share a component, otherwise the
+  // batch pays for walking several components
+  if (!component.empty()) {
+    sort(picked.begin(), picked.end(), [this](uint32_t a, uint32_t b) {
+      return component[a] != component[b] ? component[a] < component[b] : a < b;
+    });
+  }
+
+  return picked;
+}
+
+void GraphAnalytics::run(const vector<uint32_t>& sources, unsigned threads) {
+  this->sources = sources;
+  eccentricity.assign(sources.size(), 0);
+  distanceSum.assign(sources.size(), 0);
+  reached.assign(sources.size(), 0);
+  distanceHistogram.assign(1, 0);
+
+  if (threads == 0)
+    threads = 1;
+
+  size_t batches = (sources.size() + BATCH - 1) / BATCH;
+  atomic<size_t> nextBatch(0);
+  mutex merge;
+
+  // Each worker owns its search state & histogram, takes batches
+  // until none are left, then adds its histogram to the total
+  auto worker = [&]() {
+    uint32_t actorCount = graph.getActorCount();
+    vector<uint64_t> seen(actorCount), visit(actorCount), next(actorCount);
+    vector<uint64_t> histogram(1, 0);
+
+    for (size_t batch = nextBatch++; batch < batches; batch = nextBatch++) {
+      size_t first = batch * BATCH;
+      runBatch(first, min(BATCH, sources.size() - first), histogram, seen, visit, next);
+    }
+
+    lock_guard<mutex> lock(merge);
+    if (distanceHistogram.size() < histogram.size())
+      distanceHistogram.resize(histogram.size(), 0);
+    for (size_t d = 0; d < histogram.size(); ++d)
+      distanceHistogram[d] += histogram[d];
+  };
+
+  vector<thread> pool;
+  for (unsigned i = 1; i < threads; ++i)
+    pool.push_back(thread(worker));
+  worker();
+  for (auto& t : pool)
+    t.join();
+}
+
+/** Runs up to 64 BFS traversals at once. Bit b of seen[v] tells
+  * whether source b has reached v, & visit holds the bits of the
+  * current frontier. Every level the frontier bits are pushed to
+  * the neighbors that have not seen them yet.
+  *
+  * @params: first/count - range of sources, histogram - per distance
+  *          pair counts, seen/visit/next - scratch arrays (one word
+  *          per actor)
+  * @returns: void
+  */
+void GraphAnalytics::runBatch(size_t first, size_t count, vector<uint64_t>& histogram,
+                              vector<uint64_t>& seen, vector<uint64_t>& visit,
+                              vector<uint64_t>& next) {
+  fill(seen.begin(), seen.end(), 0);
+  fill(visit.begin(), visit.end(), 0);
+  fill(next.begin(), next.end(), 0);
+
+  // Actors with a non-empty frontier word
+  vector<uint32_t> frontier, nextFrontier;
+
+  for (size_t b = 0; b < count; ++b) {
+    uint32_t source = sources[first + b];
+    if (!visit[source])
+      frontier.push_back(source);
+    seen[source] |= 1ULL << b;
+    visit[source] |= 1ULL << b;
+  }
+  histogram[0] += count;
+
+  for (int level = 1; !frontier.empty(); ++level) {
+    for (auto curr : frontier) {
+      uint64_t bits = visit[curr];
+
+      for (uint32_t n = neighborOffsets[curr]; n < neighborOffsets[curr + 1]; ++n) {
+        uint32_t neighbor = neighbors[n];
+        uint64_t newBits = bits & ~seen[neighbor];
+
+        if (newBits) {
+          if (!next[neighbor])
+            nextFrontier.push_back(neighbor);
+          next[neighbor] |= newBits;
+          seen[neighbor] |= newBits;
+        }
+      }
+    }
+
+    for (auto curr : frontier)
+      visit[curr] = 0;
+
+    if (!nextFrontier.empty() && histogram.size() <= (size_t) level)
+      histogram.resize(level + 1, 0);
+
+    // Credit every source that reached an actor on this level
+    for (auto actor : nextFrontier) {
+      uint64_t bits = next[actor];
+      histogram[level] += __builtin_popcountll(bits);
+
+      while (bits) {
+        size_t b = first + __builtin_ctzll(bits);
+        eccentricity[b] = level;
+        distanceSum[b] += level;
+        ++reached[b];
+        bits &= bits - 1;
+      }
+
+      visit[actor] = next[actor];
+      next[actor] = 0;
+    }
+
+    frontier.swap(nextFrontier);
+    nextFrontier.clear();
+  }
+}
+
+double GraphAnalytics::closeness(size_t i) const {
+  return distanceSum[i] ? (double) reached[i] / distanceSum[i] : 0;
+}
+
+size_t GraphAnalytics::findCenter() const {
+  // The largest component, by the number of actors reached
+  uint32_t largest = 0;
+  for (size_t i = 0; i < sources.size(); ++i)
+    largest = max(largest, reached[i]);
+
+  size_t best = sources.size();
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (reached[i] != largest)
+      continue;
+
+    if (best == sources.size() || eccentricity[i] < eccentricity[best] ||
+        (eccentricity[i] == eccentricity[best] && closeness(i) > closeness(best)))
+      best = i;
+  }
+
+  return best;
+}
@@ -0,0 +1,81 @@
+/*
+ * GraphAnalytics.hpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This file defines graph-wide statistics over a
+ * PackedGraph: eccentricity & closeness of every actor,
+ * the connected components & the distribution of the
+ * distances between actors. Instead of one BFS per actor,
+ * up to 64 BFS traversals are run together: each actor
+ * holds one bit per source in a 64-bit word, so a single
+ * pass over an actor's neighbors advances all 64 searches.
+ * Batches of sources are spread over several threads.
+ */
+
+#ifndef GRAPHANALYTICS_HPP
+#define GRAPHANALYTICS_HPP
+
+#include <cstdint>
+#include <vector>
+#include "PackedGraph.hpp"
+
+class GraphAnalytics {
+protected:
+  const PackedGraph& graph;
+
+  // Neighbors without the repeats coming from several shared movies
+  std::vector<uint32_t> neighborOffsets;
+  std::vector<uint32_t> neighbors;
+
+  void runBatch(size_t first, size_t count, std::vector<uint64_t>& histogram,
+                std::vector<uint64_t>& seen, std::vector<uint64_t>& visit,
+                std::vector<uint64_t>& next);
+
+public:
+  // Actors the searches were started from
+  std::vector<uint32_t> sources;
+
+  /* Per-source results, same order as sources */
+  std::vector<int> eccentricity;
+  std::vector<uint64_t> distanceSum;
+  std::vector<uint32_t> reached;
+
+  // Number of (source, actor) pairs found at each distance
+  std::vector<uint64_t> distanceHistogram;
+
+  // Component of every actor & the size of each component
+  std::vector<uint32_t> component;
+  std::vector<uint32_t> componentSizes;
+
+  /* Constructor */
+  GraphAnalytics(const PackedGraph& graph);
+
+  /** Labels every actor with its connected component. */
+  void computeComponents();
+
+  /** Runs a BFS from every given source, 64 at a time.
+    *
+    * @params: sources - actor IDs, threads - number of worker threads
+    * @returns: void
+    */
+  void run(const std::vector<uint32_t>& sources, unsigned threads);
+
+  /** Picks sampleSize actors at random as sources (all when 0),
+    * grouped by component so each batch stays in one component.
+    *
+    * @params: sampleSize - how many sources, seed - random seed
+    * @returns: the chosen actor IDs
+    */
+  std::vector<uint32_t> pickSources(uint32_t sampleSize, uint64_t seed) const;
+
+  /** Closeness of the i-th source: actors reached / sum of distances */
+  double closeness(size_t i) const;
+
+  /** Index (into sources) of the most central source of the largest
+    * component: smallest eccentricity, then highest closeness.
+    */
+  size_t findCenter() const;
+};
+
+#endif // GRAPHANALYTICS_HPP
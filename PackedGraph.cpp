@@ -0,0 +1,496 @@
+/*
+ * PackedGraph.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * Implementation of the memory-budgeted graph. The
+ * file is read once into temporary per-movie cast
+ * lists, which are then flattened into the CSR arrays.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include "ActorNode.hpp"
+#include "Movie.hpp"
+#include "PackedGraph.hpp"
+#include "UnionFind.hpp"
+
+using namespace std;
+
+// Rough per-allocation bookkeeping cost of the heap allocator
+static const size_t MALLOC_OVERHEAD = 16;
+
+/** Returns the number of heap bytes owned by a string (strings
+  * short enough for the small-string buffer own none).
+  */
+static size_t stringHeapBytes(const string& s) {
+  return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+const uint32_t PackedGraph::NO_ACTOR;
+
+/* Constructor */
+PackedGraph::PackedGraph(void) {}
+
+bool PackedGraph::loadFromFile(const char* in_filename) {
+  // Initialize the file stream
+  ifstream infile(in_filename);
+
+  bool have_header = false;
+
+  // Temporary tables, dropped once the CSR arrays are built
+  unordered_map<string, uint32_t> actorIds;
+  unordered_map<string, uint32_t> movieIds;
+  vector<int> years;
+  vector<vector<uint32_t>> casts;
+
+  // keep reading lines until the end of file is reached
+  while (infile) {
+    string s;
+
+    // get the next line
+    if (!getline( infile, s )) break;
+
+    if (!have_header) {
+        // skip the header
+        have_header = true;
+        continue;
+    }
+
+    istringstream ss( s );
+    vector <string> record;
+
+    while (ss) {
+        string next;
+
+        // get the next string before hitting a tab character and put it in 'next'
+        if (!getline( ss, next, '\t' )) break;
+
+        record.push_back( next );
+    }
+
+    if (record.size() != 3) {
+        // we should have exactly 3 columns
+        continue;
+    }
+
+    int movie_year = stoi(record[2]);
+
+    // Look up (or hand out) the actor's ID
+    auto actor = actorIds.find(record[0]);
+    if (actor == actorIds.end()) {
+      actor = actorIds.emplace(record[0], (uint32_t) actorNames.size()).first;
+      actorNames.push_back(record[0]);
+    }
+
+    // Same movie key as ActorGraph: title & date
+    string movie_title_full = (record[1] + " " + to_string(movie_year));
+    auto movie = movieIds.find(movie_title_full);
+    if (movie == movieIds.end()) {
+      movie = movieIds.emplace(movie_title_full, (uint32_t) movieNames.size()).first;
+      movieNames.push_back(record[1]);
+      years.push_back(movie_year);
+      casts.emplace_back();
+    }
+
+    casts[movie->second].push_back(actor->second);
+  }
+
+  if (!infile.eof()) {
+    cerr << "Failed to read " << in_filename << "!\n";
+    return false;
+  }
+  infile.close();
+
+  // The name index replaces actorIds once loading is done
+  actorsByName.resize(actorNames.size());
+  for (uint32_t actor = 0; actor < actorNames.size(); ++actor)
+    actorsByName[actor] = actor;
+  sort(actorsByName.begin(), actorsByName.end(), [this](uint32_t a, uint32_t b) {
+    return actorNames[a] < actorNames[b];
+  });
+
+  // Years are stored as 16-bit offsets from the earliest one
+  baseYear = years.empty() ? 0 : *min_element(years.begin(), years.end());
+  movieYears.resize(years.size());
+  for (size_t i = 0; i < years.size(); ++i) {
+    if (years[i] - baseYear > 0xFFFF) {
+      cerr << "Movie years in " << in_filename << " span too many years!\n";
+      return false;
+    }
+    movieYears[i] = (uint16_t) (years[i] - baseYear);
+  }
+
+  // Count each actor's edges: one per other cast member per movie
+  vector<uint64_t> degree(actorNames.size() + 1, 0);
+  roleCount = 0;
+  for (auto& cast : casts) {
+    // An actor listed twice in a movie is still one cast member
+    sort(cast.begin(), cast.end());
+    cast.erase(unique(cast.begin(), cast.end()), cast.end());
+    roleCount += cast.size();
+
+    for (auto actor : cast)
+      degree[actor] += cast.size() - 1;
+  }
+
+  uint64_t total = 0;
+  for (auto d : degree)
+    total += d;
+
+  if (total >= NO_ACTOR) {
+    cerr << "Too many edges in " << in_filename << " for 32-bit edge IDs!\n";
+    return false;
+  }
+
+  edgeOffsets.assign(actorNames.size() + 1, 0);
+  for (size_t i = 0; i < actorNames.size(); ++i)
+    edgeOffsets[i + 1] = edgeOffsets[i] + (uint32_t) degree[i];
+
+  edgeTargets.resize(total);
+  edgeYears.resize(total);
+  edgeMovies.resize(total);
+
+  // Now fill in every actor's block, using the offsets as cursors
+  vector<uint32_t> cursor(edgeOffsets.begin(), edgeOffsets.end() - 1);
+  for (uint32_t movie = 0; movie < casts.size(); ++movie) {
+    for (auto actor : casts[movie]) {
+      for (auto otherActor : casts[movie]) {
+        if (actor != otherActor) {
+          uint32_t edge = cursor[actor]++;
+          edgeTargets[edge] = otherActor;
+          edgeYears[edge] = movieYears[movie];
+          edgeMovies[edge] = movie;
+        }
+      }
+    }
+  }
+
+  buildComponents(casts, years);
+  buildBiconnected();
+
+  dist.assign(actorNames.size(), -1);
+  prev.assign(actorNames.size(), NO_ACTOR);
+
+  return true;
+}
+
+/** Finds the connected components by adding the movies' casts to a
+  * union-find in release order (like ActorGraph::buildComponents()),
+  * which also gives the year each component reached its final form.
+  *
+  * @params: casts & years - the per-movie tables read from the file
+  * @returns: void
+  */
+void PackedGraph::buildComponents(const vector<vector<uint32_t>>& casts,
+                                  const vector<int>& years) {
+  vector<uint32_t> order(casts.size());
+  for (uint32_t movie = 0; movie < order.size(); ++movie)
+    order[movie] = movie;
+
+  stable_sort(order.begin(), order.end(), [&years](uint32_t a, uint32_t b) {
+    return years[a] < years[b];
+  });
+
+  UnionFind sets((int) actorNames.size());
+  for (auto movie : order) {
+    for (auto actor : casts[movie]) {
+      sets.touch(actor, years[movie]);
+      sets.merge(casts[movie][0], actor, years[movie]);
+    }
+  }
+
+  // Number the components by their representative
+  vector<uint32_t> label(actorNames.size(), NO_ACTOR);
+  components.resize(actorNames.size());
+  componentYears.clear();
+
+  for (uint32_t actor = 0; actor < actorNames.size(); ++actor) {
+    int root = sets.find(actor);
+
+    if (label[root] == NO_ACTOR) {
+      label[root] = (uint32_t) componentYears.size();
+      componentYears.push_back(sets.getYear(root));
+    }
+    components[actor] = label[root];
+  }
+}
+
+/** Finds the articulation actors & counts the biconnected components
+  * with Tarjan's algorithm: an actor is an articulation actor when
+  * none of the actors below one of its DFS children can reach above
+  * it without going through it. The DFS keeps its own stack, since
+  * paths through the graph can be far deeper than the call stack.
+  */
+void PackedGraph::buildBiconnected() {
+  uint32_t actorCount = (uint32_t) actorNames.size();
+  articulation.assign(actorCount, false);
+  biconnectedCount = 0;
+
+  // Discovery time (0 = not visited) & lowest time reachable below
+  vector<uint32_t> discovered(actorCount, 0);
+  vector<uint32_t> low(actorCount, 0);
+  uint32_t time = 0;
+
+  struct Frame {
+    uint32_t actor;
+    uint32_t edge;          // next edge to look at
+    uint32_t parent;
+    bool skippedParent;     // the edge back to parent is not a back edge
+  };
+  vector<Frame> stack;
+
+  for (uint32_t root = 0; root < actorCount; ++root) {
+    if (discovered[root])
+      continue;
+
+    discovered[root] = low[root] = ++time;
+    uint32_t rootChildren = 0;
+    stack.push_back(Frame{root, edgeOffsets[root], NO_ACTOR, false});
+
+    while (!stack.empty()) {
+      Frame& frame = stack.back();
+      uint32_t curr = frame.actor;
+
+      if (frame.edge < edgeOffsets[curr + 1]) {
+        uint32_t next = edgeTargets[frame.edge++];
+
+        // Another movie shared with the parent is a real back edge
+        if (next == frame.parent && !frame.skippedParent) {
+          frame.skippedParent = true;
+          continue;
+        }
+
+        if (!discovered[next]) {
+          discovered[next] = low[next] = ++time;
+          stack.push_back(Frame{next, edgeOffsets[next], curr, false});
+        }
+        else
+          low[curr] = min(low[curr], discovered[next]);
+        continue;
+      }
+
+      // Every edge of curr is done: report it to its parent
+      uint32_t parent = frame.parent;
+      stack.pop_back();
+      if (parent == NO_ACTOR)
+        continue;
+
+      low[parent] = min(low[parent], low[curr]);
+      if (low[curr] >= discovered[parent]) {
+        // The edges below (& including) parent-curr form a block
+        ++biconnectedCount;
+        if (parent != root)
+          articulation[parent] = true;
+        else
+          ++rootChildren;
+      }
+    }
+
+    // The root only splits its component if it has several DFS children
+    articulation[root] = (rootChildren > 1);
+  }
+}
+
+/** Runs a BFS traversal from the given starting actor. Every
+  * reached actor gets its hop count in dist & the actor it was
+  * reached from in prev.
+  *
+  * @params: start - ID of the starting actor
+  * @returns: void
+  */
+void PackedGraph::BFS(uint32_t start) {
+  fill(dist.begin(), dist.end(), -1);
+  fill(prev.begin(), prev.end(), NO_ACTOR);
+
+  // A plain vector serves as the queue: every actor is pushed once
+  vector<uint32_t> toExplore;
+  toExplore.reserve(actorNames.size());
+  dist[start] = 0;
+  toExplore.push_back(start);
+
+  for (size_t head = 0; head < toExplore.size(); ++head) {
+    uint32_t curr = toExplore[head];
+
+    for (uint32_t edge = edgeOffsets[curr]; edge < edgeOffsets[curr + 1]; ++edge) {
+      uint32_t neighbor = edgeTargets[edge];
+
+      // If the actor hasn't already been visited, update it
+      if (dist[neighbor] == -1) {
+        dist[neighbor] = dist[curr] + 1;
+        prev[neighbor] = curr;
+        toExplore.push_back(neighbor);
+      }
+    }
+  }
+}
+
+/** Runs Dijkstra's algorithm from the given starting actor using
+  * the same weights as ActorGraph (1 + (2015 - year)). Stale queue
+  * entries are skipped instead of being decreased in place.
+  *
+  * @params: start - ID of the starting actor
+  * @returns: void
+  */
+void PackedGraph::Dijkstra(uint32_t start) {
+  fill(dist.begin(), dist.end(), -1);
+  fill(prev.begin(), prev.end(), NO_ACTOR);
+
+  typedef pair<int, uint32_t> Entry;
+  priority_queue<Entry, vector<Entry>, greater<Entry>> pq;
+
+  dist[start] = 0;
+  pq.push(Entry(0, start));
+
+  while (!pq.empty()) {
+    Entry top = pq.top();
+    pq.pop();
+
+    uint32_t curr = top.second;
+    if (top.first != dist[curr])
+      continue;
+
+    for (uint32_t edge = edgeOffsets[curr]; edge < edgeOffsets[curr + 1]; ++edge) {
+      uint32_t otherActor = edgeTargets[edge];
+      int newDist = dist[curr] + edgeWeight(edge);
+
+      if (dist[otherActor] == -1 || newDist < dist[otherActor]) {
+        dist[otherActor] = newDist;
+        prev[otherActor] = curr;
+        pq.push(Entry(newDist, otherActor));
+      }
+    }
+  }
+}
+
+/** Finds the movie linking two actors by scanning the first one's
+  * edges. The latest movie wins & ties go to the title that sorts
+  * first, just like MovieComp in ActorGraph.
+  *
+  * @params: 2 actor IDs
+  * @returns: the movie ID, or NO_ACTOR if they share no movie
+  */
+uint32_t PackedGraph::findCommonMovie(uint32_t actor1, uint32_t actor2) const {
+  uint32_t best = NO_ACTOR;
+
+  for (uint32_t edge = edgeOffsets[actor1]; edge < edgeOffsets[actor1 + 1]; ++edge) {
+    if (edgeTargets[edge] != actor2)
+      continue;
+
+    uint32_t movie = edgeMovies[edge];
+    if (best == NO_ACTOR || movieYears[movie] > movieYears[best] ||
+        (movieYears[movie] == movieYears[best] && movieNames[movie] < movieNames[best]))
+      best = movie;
+  }
+
+  return best;
+}
+
+/** Prints a path given as a list of actors, picking the movie
+  * between every two of them with findCommonMovie().
+  *
+  * @params: path - actor IDs from first to last, out - output stream
+  * @returns: void
+  */
+void PackedGraph::exportPath(const vector<uint32_t>& path, ostream& out) const {
+  out << "(" << actorNames[path[0]] << ")";
+
+  for (size_t i = 1; i < path.size(); ++i) {
+    uint32_t movie = findCommonMovie(path[i - 1], path[i]);
+
+    out << "--[" << movieNames[movie] << "#@" << movieYear(movie) << "]-->"
+        << "(" << actorNames[path[i]] << ")";
+  }
+}
+
+/** Prints a path whose movies were picked by the caller.
+  *
+  * @params: path - actor IDs, movies - the movie between path[i]
+  *          & path[i + 1], out - output stream
+  * @returns: void
+  */
+void PackedGraph::exportPath(const vector<uint32_t>& path, const vector<uint32_t>& movies,
+                             ostream& out) const {
+  out << "(" << actorNames[path[0]] << ")";
+
+  for (size_t i = 1; i < path.size(); ++i) {
+    out << "--[" << movieNames[movies[i - 1]] << "#@" << movieYear(movies[i - 1]) << "]-->"
+        << "(" << actorNames[path[i]] << ")";
+  }
+}
+
+/** Prints a capacity report: bytes per actor, edge & movie for the
+  * packed layout next to an estimate for ActorGraph's layout, along
+  * with the totals projected for a graph scale times larger.
+  *
+  * @params: out - stream to print to, scale - growth factor
+  * @returns: void
+  */
+void PackedGraph::reportMemory(ostream& out, double scale) const {
+  double actors = actorNames.size();
+  double edges = edgeTargets.size();
+  double movies = movieNames.size();
+  double roles = roleCount;
+
+  size_t actorNameBytes = 0;
+  for (auto& name : actorNames)
+    actorNameBytes += sizeof(string) + stringHeapBytes(name);
+
+  size_t movieNameBytes = 0;
+  for (auto& name : movieNames)
+    movieNameBytes += sizeof(string) + stringHeapBytes(name);
+
+  double avgActorName = actors ? actorNameBytes / actors : 0;
+  double avgMovieName = movies ? movieNameBytes / movies : 0;
+  // One hash map node: key string, value pointer, next pointer & cached hash
+  double mapNode = 3 * sizeof(void*) + MALLOC_OVERHEAD;
+
+  /* Packed layout */
+  double hotActor = sizeof(uint32_t)                          // edgeOffsets
+                  + sizeof(uint32_t)                           // component
+                  + sizeof(int) + sizeof(uint32_t);            // dist & prev
+  double coldActor = avgActorName + sizeof(uint32_t)          // name & name index
+                   + 1.0 / 8;                                  // articulation bit
+  double hotEdge = sizeof(uint32_t) + sizeof(uint16_t);        // target & year
+  double coldEdge = sizeof(uint32_t);                          // movie
+  double movie = sizeof(uint16_t) + avgMovieName;
+  double packed = actors * (hotActor + coldActor) + edges * (hotEdge + coldEdge)
+                + movies * movie;
+
+  /* ActorGraph layout (estimated from the same counts) */
+  double legacyActor = sizeof(ActorNode) + MALLOC_OVERHEAD + avgActorName
+                     + avgActorName + mapNode;                 // actorsMap entry
+  double legacyRole = avgMovieName + 5                         // movieList entry
+                    + avgActorName + mapNode;                  // Movie::cast entry
+  double legacyEdge = sizeof(ActorEdge) + MALLOC_OVERHEAD + sizeof(ActorEdge*);
+  double legacyMovie = sizeof(Movie) + MALLOC_OVERHEAD + avgMovieName
+                     + avgMovieName + 5 + mapNode              // movies entry
+                     + sizeof(Movie*);                         // movieByYear entry
+  double legacy = actors * legacyActor + roles * legacyRole + edges * legacyEdge
+                + movies * legacyMovie;
+
+  out << "actors: " << actorNames.size() << "\tedges: " << edgeTargets.size()
+      << "\tmovies: " << movieNames.size() << "\troles: " << (size_t) roles << "\n";
+  out << "layout\tbytes/actor\tbytes/edge\tbytes/movie\ttotal MB\t"
+      << "total MB (x" << scale << ")\n";
+  out << "packed\t" << hotActor + coldActor << " (hot " << hotActor << ")\t"
+      << hotEdge + coldEdge << " (hot " << hotEdge << ")\t" << movie << "\t"
+      << packed / (1 << 20) << "\t" << scale * packed / (1 << 20) << "\n";
+  out << "ActorGraph\t" << legacyActor + (actors ? roles / actors : 0) * legacyRole
+      << "\t" << legacyEdge << "\t" << legacyMovie << "\t"
+      << legacy / (1 << 20) << "\t" << scale * legacy / (1 << 20) << "\n";
+}
+
+/** Looks up an actor's ID by name.
+  *
+  * @params: the actor's name
+  * @returns: the actor's ID, or NO_ACTOR if not in the graph
+  */
+uint32_t PackedGraph::findActor(const string& name) const {
+  auto actor = lower_bound(actorsByName.begin(), actorsByName.end(), name,
+                           [this](uint32_t a, const string& b) { return actorNames[a] < b; });
+  return (actor == actorsByName.end() || actorNames[*actor] != name) ? NO_ACTOR : *actor;
+}
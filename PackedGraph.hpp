@@ -0,0 +1,133 @@
+/*
+ * PackedGraph.hpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This file defines a memory-budgeted version of the actor
+ * graph. Actors & movies are referred to by 32-bit IDs and
+ * every actor's edges live in one contiguous block (CSR).
+ * The data used during a traversal (edge targets & 16-bit
+ * year deltas) is kept apart from the data only needed to
+ * print a path (actor names, movie names, movie IDs).
+ */
+
+#ifndef PACKEDGRAPH_HPP
+#define PACKEDGRAPH_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+class PackedGraph {
+protected:
+  /* Hot data: read by every traversal */
+
+  // Actor i's edges are [edgeOffsets[i], edgeOffsets[i + 1])
+  std::vector<uint32_t> edgeOffsets;
+  // The actor on the other end of each edge
+  std::vector<uint32_t> edgeTargets;
+  // Release year of the edge's movie, stored as (year - baseYear)
+  std::vector<uint16_t> edgeYears;
+
+  // Connected component of every actor & the year each component
+  // reached its final form
+  std::vector<uint32_t> components;
+  std::vector<int> componentYears;
+
+  // Actors whose removal would disconnect their component, & the
+  // number of biconnected components (blocks of edges that stay
+  // connected when any one actor is removed)
+  std::vector<bool> articulation;
+  uint32_t biconnectedCount = 0;
+
+  /* Cold data: only read when printing results */
+
+  // The movie each edge goes through
+  std::vector<uint32_t> edgeMovies;
+  std::vector<std::string> actorNames;
+  std::vector<std::string> movieNames;
+  std::vector<uint16_t> movieYears;
+  // Actor IDs in name order, so names are looked up by binary
+  // search rather than through a second copy of every name
+  std::vector<uint32_t> actorsByName;
+
+  // Year every stored delta is relative to
+  int baseYear = 0;
+
+  // Number of (actor, movie) pairs read, only used for reporting
+  uint64_t roleCount = 0;
+
+  void buildComponents(const std::vector<std::vector<uint32_t>>& casts,
+                       const std::vector<int>& years);
+  void buildBiconnected();
+
+public:
+  // Returned when an actor could not be found/has no predecessor
+  static const uint32_t NO_ACTOR = 0xFFFFFFFF;
+
+  /* Traversal state, indexed by actor ID */
+  std::vector<int> dist;
+  std::vector<uint32_t> prev;
+
+  /* Constructor */
+  PackedGraph(void);
+
+  /** Load the graph from a tab-delimited file of actor->movie
+    * relationships (same format ActorGraph reads).
+    *
+    * @params: in_filename - input filename
+    * @returns: true if file was loaded sucessfully, false otherwise
+    */
+  bool loadFromFile(const char* in_filename);
+
+  /** Unweighted BFS from start, filling dist & prev */
+  void BFS(uint32_t start);
+
+  /** Dijkstra with weight 1 + (2015 - year), filling dist & prev */
+  void Dijkstra(uint32_t start);
+
+  /** Picks the movie printed between two adjacent actors: the
+    * latest shared one, ties broken by title (same as ActorGraph).
+    */
+  uint32_t findCommonMovie(uint32_t actor1, uint32_t actor2) const;
+
+  /** Prints a path given as actor IDs using the
+    * (actor)--[movie#@year]-->(actor) format.
+    */
+  void exportPath(const std::vector<uint32_t>& path, std::ostream& out) const;
+
+  /** Same, with the movie of every step already known. */
+  void exportPath(const std::vector<uint32_t>& path, const std::vector<uint32_t>& movies,
+                  std::ostream& out) const;
+
+  /** Prints how many bytes every actor/edge/movie takes, both for
+    * this layout & for the pointer based ActorGraph.
+    *
+    * @params: out - stream to print to, scale - growth factor to project
+    */
+  void reportMemory(std::ostream& out, double scale) const;
+
+  /* Getters */
+  uint32_t findActor(const std::string& name) const;
+  uint32_t getActorCount() const { return (uint32_t) actorNames.size(); }
+  uint32_t getMovieCount() const { return (uint32_t) movieNames.size(); }
+  uint32_t getEdgeCount() const { return (uint32_t) edgeTargets.size(); }
+  uint32_t edgesBegin(uint32_t actor) const { return edgeOffsets[actor]; }
+  uint32_t edgesEnd(uint32_t actor) const { return edgeOffsets[actor + 1]; }
+  uint32_t edgeTarget(uint32_t edge) const { return edgeTargets[edge]; }
+  uint32_t edgeMovie(uint32_t edge) const { return edgeMovies[edge]; }
+  int edgeYear(uint32_t edge) const { return baseYear + edgeYears[edge]; }
+  int edgeWeight(uint32_t edge) const { return (2015 - edgeYear(edge)) + 1; }
+  int movieYear(uint32_t movie) const { return baseYear + movieYears[movie]; }
+  const std::string& actorName(uint32_t actor) const { return actorNames[actor]; }
+  const std::string& movieName(uint32_t movie) const { return movieNames[movie]; }
+  uint32_t getComponent(uint32_t actor) const { return components[actor]; }
+  uint32_t getComponentCount() const { return (uint32_t) componentYears.size(); }
+  int getComponentYear(uint32_t component) const { return componentYears[component]; }
+  bool isArticulation(uint32_t actor) const { return articulation[actor]; }
+  uint32_t getBiconnectedCount() const { return biconnectedCount; }
+};
+
+#endif // PACKEDGRAPH_HPP
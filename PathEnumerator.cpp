@@ -0,0 +1,258 @@
+/*
+ * PathEnumerator.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * Implementation of the shortest-path DAG search,
+ * counting & lazy path enumeration.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include "PathEnumerator.hpp"
+
+using namespace std;
+
+static const uint32_t NONE = PackedGraph::NO_ACTOR;
+
+/** Adds two path counts, sticking at UINT64_MAX on overflow */
+static uint64_t saturatingAdd(uint64_t a, uint64_t b) {
+  return (a > UINT64_MAX - b) ? UINT64_MAX : a + b;
+}
+
+/* Constructor */
+PathEnumerator::PathEnumerator(const PackedGraph& graph) :
+  graph(graph),
+  dist(graph.getActorCount(), -1),
+  localIndex(graph.getActorCount(), NONE) {}
+
+bool PathEnumerator::compute(uint32_t start, uint32_t end, bool weighted) {
+  // Only reset what the last query touched
+  for (auto actor : nodes)
+    localIndex[actor] = NONE;
+  nodes.clear();
+  predOffsets.clear();
+  preds.clear();
+  counts.clear();
+  stack.clear();
+  position.clear();
+
+  this->start = start;
+  this->end = end;
+
+  if (start == NONE || end == NONE ||
+      graph.getComponent(start) != graph.getComponent(end))
+    return false;
+
+  search(weighted);
+
+  if (dist[end] == -1)
+    return false;
+
+  buildDAG(weighted);
+  countPaths();
+
+  // Enumeration walks back from end
+  stack.push_back(0);
+  position.push_back(predOffsets[0]);
+
+  return true;
+}
+
+/** Runs the search from start, stopping as soon as every actor
+  * that could be on a shortest path to end has its final distance.
+  *
+  * @params: weighted - BFS layers if false, Dijkstra if true
+  * @returns: void
+  */
+void PathEnumerator::search(bool weighted) {
+  fill(dist.begin(), dist.end(), -1);
+  dist[start] = 0;
+
+  if (!weighted) {
+    // Everything one layer closer than end is known once end is reached
+    vector<uint32_t> toExplore(1, start);
+
+    for (size_t head = 0; head < toExplore.size() && dist[end] == -1; ++head) {
+      uint32_t curr = toExplore[head];
+
+      for (uint32_t edge = graph.edgesBegin(curr); edge < graph.edgesEnd(curr); ++edge) {
+        uint32_t neighbor = graph.edgeTarget(edge);
+
+        if (dist[neighbor] == -1) {
+          dist[neighbor] = dist[curr] + 1;
+          toExplore.push_back(neighbor);
+        }
+      }
+    }
+    return;
+  }
+
+  typedef pair<int, uint32_t> Entry;
+  priority_queue<Entry, vector<Entry>, greater<Entry>> pq;
+  pq.push(Entry(0, start));
+
+  while (!pq.empty()) {
+    Entry top = pq.top();
+    pq.pop();
+
+    uint32_t curr = top.second;
+    if (top.first != dist[curr])
+      continue;
+
+    // Every actor at most as far as end is now settled
+    if (dist[end] != -1 && top.first > dist[end])
+      break;
+
+    for (uint32_t edge = graph.edgesBegin(curr); edge < graph.edgesEnd(curr); ++edge) {
+      uint32_t otherActor = graph.edgeTarget(edge);
+      int newDist = dist[curr] + graph.edgeWeight(edge);
+
+      if (dist[otherActor] == -1 || newDist < dist[otherActor]) {
+        dist[otherActor] = newDist;
+        pq.push(Entry(newDist, otherActor));
+      }
+    }
+  }
+}
+
+/** Collects the shortest-path DAG by walking back from end: an
+  * actor u is a predecessor of v when dist[u] + weight == dist[v].
+  * Actors sharing several movies are only listed once.
+  *
+  * @params: weighted - whether the movie year weights are used
+  * @returns: void
+  */
+void PathEnumerator::buildDAG(bool weighted) {
+  localIndex[end] = 0;
+  nodes.push_back(end);
+
+  // addedBy[j] is 1 + the node j was last listed as a predecessor of
+  vector<uint32_t> addedBy(1, 0);
+
+  // Nodes are expanded in the order they get their index, so each
+  // node's predecessors are appended right after the previous one's
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    uint32_t curr = nodes[i];
+    predOffsets.push_back((uint32_t) preds.size());
+
+    for (uint32_t edge = graph.edgesBegin(curr); edge < graph.edgesEnd(curr); ++edge) {
+      uint32_t otherActor = graph.edgeTarget(edge);
+      int weight = weighted ? graph.edgeWeight(edge) : 1;
+
+      if (dist[otherActor] == -1 || dist[otherActor] + weight != dist[curr])
+        continue;
+
+      if (localIndex[otherActor] == NONE) {
+        localIndex[otherActor] = (uint32_t) nodes.size();
+        nodes.push_back(otherActor);
+        addedBy.push_back(0);
+      }
+
+      // Skip the repeats coming from other shared movies
+      uint32_t local = localIndex[otherActor];
+      if (addedBy[local] != i + 1) {
+        addedBy[local] = (uint32_t) (i + 1);
+        preds.push_back(local);
+      }
+    }
+  }
+  predOffsets.push_back((uint32_t) preds.size());
+}
+
+/** Counts the paths from start to every DAG node, visiting the
+  * nodes by increasing distance so predecessors come first.
+  */
+void PathEnumerator::countPaths() {
+  vector<uint32_t> order(nodes.size());
+  for (uint32_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+
+  sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+    return dist[nodes[a]] < dist[nodes[b]];
+  });
+
+  counts.assign(nodes.size(), 0);
+  for (auto node : order) {
+    if (nodes[node] == start) {
+      counts[node] = 1;
+      continue;
+    }
+
+    for (uint32_t p = predOffsets[node]; p < predOffsets[node + 1]; ++p)
+      counts[node] = saturatingAdd(counts[node], counts[preds[p]]);
+  }
+}
+
+bool PathEnumerator::next(vector<uint32_t>& path) {
+  // Depth first walk back from end, yielding whenever start is hit
+  while (!stack.empty()) {
+    uint32_t node = stack.back();
+
+    if (nodes[node] == start) {
+      path.clear();
+      for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+        path.push_back(nodes[*it]);
+
+      stack.pop_back();
+      position.pop_back();
+      return true;
+    }
+
+    if (position.back() == predOffsets[node + 1]) {
+      stack.pop_back();
+      position.pop_back();
+      continue;
+    }
+
+    uint32_t pred = preds[position.back()++];
+    stack.push_back(pred);
+    position.push_back(predOffsets[pred]);
+  }
+
+  return false;
+}
+
+bool PathEnumerator::sample(vector<uint32_t>& path, mt19937_64& rng) const {
+  if (nodes.empty())
+    return false;
+
+  // Walking back, each predecessor is chosen in proportion to the
+  // number of paths reaching it, which makes every path equally likely
+  path.clear();
+  uint32_t node = 0;
+  path.push_back(nodes[node]);
+
+  while (nodes[node] != start) {
+    double total = 0;
+    for (uint32_t p = predOffsets[node]; p < predOffsets[node + 1]; ++p)
+      total += (double) counts[preds[p]];
+
+    double pick = uniform_real_distribution<double>(0, total)(rng);
+    uint32_t chosen = preds[predOffsets[node + 1] - 1];
+
+    for (uint32_t p = predOffsets[node]; p < predOffsets[node + 1]; ++p) {
+      pick -= (double) counts[preds[p]];
+      if (pick < 0) {
+        chosen = preds[p];
+        break;
+      }
+    }
+
+    node = chosen;
+    path.push_back(nodes[node]);
+  }
+
+  reverse(path.begin(), path.end());
+  return true;
+}
+
+/* Getters */
+uint64_t PathEnumerator::getPathCount() const {
+  return counts.empty() ? 0 : counts[0];
+}
+
+int PathEnumerator::getDistance() const {
+  return counts.empty() ? -1 : dist[end];
+}
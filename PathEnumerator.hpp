@@ -0,0 +1,88 @@
+/*
+ * PathEnumerator.hpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This file defines a helper that finds every shortest
+ * path between two actors of a PackedGraph. One search
+ * from the first actor builds the shortest-path DAG back
+ * from the second actor & counts the paths through it.
+ * The paths themselves are only produced on request, one
+ * at a time, so pairs with millions of shortest paths can
+ * still be answered with a bounded output.
+ *
+ * Paths are counted at the actor level: two actors that
+ * share several movies form one step of a path, printed
+ * with the movie findCommonMovie() picks.
+ */
+
+#ifndef PATHENUMERATOR_HPP
+#define PATHENUMERATOR_HPP
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "PackedGraph.hpp"
+
+class PathEnumerator {
+protected:
+  const PackedGraph& graph;
+  uint32_t start = PackedGraph::NO_ACTOR;
+  uint32_t end = PackedGraph::NO_ACTOR;
+
+  // Distance of every actor from start (-1 if not reached)
+  std::vector<int> dist;
+
+  // Actors of the DAG (back from end) & their index in it
+  std::vector<uint32_t> nodes;
+  std::vector<uint32_t> localIndex;
+
+  // Node i's predecessors are preds[predOffsets[i], predOffsets[i + 1])
+  std::vector<uint32_t> predOffsets;
+  std::vector<uint32_t> preds;
+
+  // Number of shortest paths from start to each node (saturated)
+  std::vector<uint64_t> counts;
+
+  // Enumeration state: the DAG nodes on the current partial path
+  // & the next predecessor to try for each of them
+  std::vector<uint32_t> stack;
+  std::vector<uint32_t> position;
+
+  void search(bool weighted);
+  void buildDAG(bool weighted);
+  void countPaths();
+
+public:
+  /* Constructor */
+  PathEnumerator(const PackedGraph& graph);
+
+  /** Finds all shortest paths from start to end & resets the
+    * enumeration.
+    *
+    * @params: 2 actor IDs, weighted - use the movie year weights
+    * @returns: true if end can be reached from start
+    */
+  bool compute(uint32_t start, uint32_t end, bool weighted);
+
+  /** Produces the next shortest path, actors from start to end.
+    *
+    * @params: path - filled with the path
+    * @returns: false once every path has been produced
+    */
+  bool next(std::vector<uint32_t>& path);
+
+  /** Picks one of the shortest paths uniformly at random.
+    *
+    * @params: path - filled with the path, rng - random source
+    * @returns: false if there is no path
+    */
+  bool sample(std::vector<uint32_t>& path, std::mt19937_64& rng) const;
+
+  /* Getters */
+  uint64_t getPathCount() const;
+  bool isCountSaturated() const { return getPathCount() == UINT64_MAX; }
+  int getDistance() const;
+};
+
+#endif // PATHENUMERATOR_HPP
@@ -0,0 +1,216 @@
+/*
+ * ResultWriter.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * Implementation of the buffered output file & its
+ * I/O thread.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "ResultWriter.hpp"
+
+using namespace std;
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+const size_t ResultWriter::BUFFER_SIZE;
+const size_t ResultWriter::MAX_PENDING;
+
+/* Constructor */
+ResultWriter::ResultWriter(const string& filename, bool useWritev)
+    : filename(filename), useWritev(useWritev) {
+  fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  // Leave room for the line that goes past the limit
+  current.reserve(BUFFER_SIZE + BUFFER_SIZE / 4);
+  worker = thread(&ResultWriter::run, this);
+}
+
+/* Destructor */
+ResultWriter::~ResultWriter() {
+  close();
+}
+
+ResultWriter& ResultWriter::operator<<(const string& text) {
+  current.append(text);
+  if (current.size() >= BUFFER_SIZE)
+    handOff();
+  return *this;
+}
+
+ResultWriter& ResultWriter::operator<<(const char* text) {
+  current.append(text);
+  if (current.size() >= BUFFER_SIZE)
+    handOff();
+  return *this;
+}
+
+ResultWriter& ResultWriter::operator<<(char c) {
+  current.push_back(c);
+  if (current.size() >= BUFFER_SIZE)
+    handOff();
+  return *this;
+}
+
+ResultWriter& ResultWriter::operator<<(int number) {
+  // Digits are produced backwards, then appended in order
+  char digits[12];
+  int length = 0;
+  unsigned int value = (number < 0) ? 0u - (unsigned int) number : (unsigned int) number;
+  do {
+    digits[length++] = (char) ('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+
+  if (number < 0)
+    current.push_back('-');
+  while (length > 0)
+    current.push_back(digits[--length]);
+
+  if (current.size() >= BUFFER_SIZE)
+    handOff();
+  return *this;
+}
+
+/** Queues the current buffer for the I/O thread & continues in a
+  * spare one, waiting if the I/O thread is too far behind.
+  */
+void ResultWriter::handOff() {
+  unique_lock<mutex> guard(lock);
+  room.wait(guard, [this] { return pending.size() < MAX_PENDING; });
+
+  pending.push_back(string());
+  pending.back().swap(current);
+
+  // Reuse a written buffer (keeping its capacity) if there is one
+  if (!spare.empty()) {
+    current.swap(spare.back());
+    spare.pop_back();
+  }
+  else
+    current.reserve(BUFFER_SIZE + BUFFER_SIZE / 4);
+
+  guard.unlock();
+  wake.notify_one();
+}
+
+/** I/O thread: writes the pending buffers until closed. */
+void ResultWriter::run() {
+  vector<string> batch;
+
+  while (true) {
+    unique_lock<mutex> guard(lock);
+    wake.wait(guard, [this] { return closing || !pending.empty(); });
+    if (pending.empty())
+      return;
+
+    batch.swap(pending);
+    guard.unlock();
+
+    writeBuffers(batch);
+
+    // Give the emptied buffers back for reuse
+    guard.lock();
+    for (auto& buffer : batch) {
+      buffer.clear();
+      spare.push_back(string());
+      spare.back().swap(buffer);
+    }
+    batch.clear();
+    guard.unlock();
+    room.notify_one();
+  }
+}
+
+/** Writes the given buffers in order, either with one writev call per
+  * IOV_MAX buffers or with one write call per buffer. On an error the
+  * rest is dropped & failed is set.
+  */
+void ResultWriter::writeBuffers(vector<string>& buffers) {
+  // Nothing after a failure, so the file never has gaps
+  if (fd == -1 || failed)
+    return;
+
+  if (!useWritev) {
+    for (auto& buffer : buffers) {
+      size_t done = 0;
+      while (done < buffer.size()) {
+        ssize_t written = ::write(fd, buffer.data() + done, buffer.size() - done);
+        if (written < 0 && errno == EINTR)
+          continue;
+        if (written <= 0) {
+          failed = true;
+          return;
+        }
+        done += (size_t) written;
+      }
+    }
+    return;
+  }
+
+  vector<struct iovec> parts;
+  for (auto& buffer : buffers) {
+    if (buffer.empty())
+      continue;
+    struct iovec part;
+    part.iov_base = (void*) buffer.data();
+    part.iov_len = buffer.size();
+    parts.push_back(part);
+  }
+
+  size_t first = 0;
+  while (first < parts.size()) {
+    int count = (int) min(parts.size() - first, (size_t) IOV_MAX);
+    ssize_t written = ::writev(fd, &parts[first], count);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0) {
+      failed = true;
+      return;
+    }
+
+    // Skip what was written, which may end in the middle of a buffer
+    size_t left = (size_t) written;
+    while (first < parts.size() && left >= parts[first].iov_len) {
+      left -= parts[first].iov_len;
+      ++first;
+    }
+    if (left > 0) {
+      parts[first].iov_base = (char*) parts[first].iov_base + left;
+      parts[first].iov_len -= left;
+    }
+  }
+}
+
+bool ResultWriter::close() {
+  if (!worker.joinable())
+    return !failed;
+
+  // The last buffer is written by the I/O thread like the others
+  {
+    lock_guard<mutex> guard(lock);
+    if (!current.empty()) {
+      pending.push_back(string());
+      pending.back().swap(current);
+    }
+    closing = true;
+  }
+  wake.notify_one();
+  worker.join();
+
+  if (fd != -1 && ::close(fd) != 0)
+    failed = true;
+  fd = -1;
+
+  if (failed)
+    cerr << "Failed to write " << filename << "!\n";
+  return !failed;
+}
@@ -0,0 +1,81 @@
+/*
+ * ResultWriter.hpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This file defines a buffered output file for the result
+ * files of pathfinder & actorconnections. Results are
+ * formatted into a large buffer; once it is full, it is
+ * handed to a separate I/O thread & formatting goes on in
+ * another buffer, so the searches never wait on the disk
+ * (nor flush after every line like endl does). Written
+ * buffers are kept & reused rather than reallocated. The
+ * I/O thread can write every waiting buffer at once with a
+ * single writev call.
+ */
+
+#ifndef RESULTWRITER_HPP
+#define RESULTWRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ResultWriter {
+protected:
+  std::string filename;
+  int fd;
+  bool useWritev;
+  // Set by the I/O thread when a write fails, reported by close()
+  bool failed = false;
+
+  // Buffer currently being formatted into
+  std::string current;
+
+  /* Shared with the I/O thread, guarded by lock */
+  std::vector<std::string> pending;   // full buffers, in order
+  std::vector<std::string> spare;     // written buffers to reuse
+  bool closing = false;
+  std::mutex lock;
+  std::condition_variable wake;       // work for the I/O thread
+  std::condition_variable room;       // a pending buffer was written
+
+  std::thread worker;
+
+  void handOff();
+  void run();
+  void writeBuffers(std::vector<std::string>& buffers);
+
+public:
+  // Size a buffer reaches before it is handed to the I/O thread
+  static const size_t BUFFER_SIZE = 1 << 20;
+  // Full buffers allowed to wait before formatting blocks
+  static const size_t MAX_PENDING = 4;
+
+  /* Constructor: truncates or creates the file */
+  ResultWriter(const std::string& filename, bool useWritev = true);
+
+  /* Destructor: writes whatever is left */
+  ~ResultWriter();
+
+  /** Appends text to the output */
+  ResultWriter& operator<<(const std::string& text);
+  ResultWriter& operator<<(const char* text);
+  ResultWriter& operator<<(char c);
+  ResultWriter& operator<<(int number);
+
+  /** Writes everything appended so far & closes the file, printing
+    * an error if any of it could not be written.
+    *
+    * @returns: true if everything was written
+    */
+  bool close();
+
+  /** true if the file could be opened */
+  bool isOpen() const { return fd != -1; }
+};
+
+#endif // RESULTWRITER_HPP
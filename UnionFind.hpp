@@ -0,0 +1,72 @@
+/*
+ * UnionFind.hpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * A disjoint-set structure over the integers [0, size)
+ * with union by rank & path compression. Every set also
+ * remembers the last year it grew, which is the year it
+ * reached its final form once all movies have been added
+ * in release order.
+ */
+
+#ifndef UNIONFIND_HPP
+#define UNIONFIND_HPP
+
+#include <algorithm>
+#include <vector>
+
+class UnionFind {
+protected:
+  std::vector<int> parent;
+  std::vector<int> rank;
+  std::vector<int> year;
+
+public:
+  /* Constructor */
+  UnionFind(int size) : parent(size), rank(size, 0), year(size, -1) {
+    for (int i = 0; i < size; ++i)
+      parent[i] = i;
+  }
+
+  /** Finds the representative of x's set, compressing the path */
+  int find(int x) {
+    while (parent[x] != x) {
+      parent[x] = parent[parent[x]];
+      x = parent[x];
+    }
+    return x;
+  }
+
+  /** Records the year x first shows up (later calls are ignored) */
+  void touch(int x, int when) {
+    int root = find(x);
+    if (year[root] == -1)
+      year[root] = when;
+  }
+
+  /** Joins the sets of a & b in the given year.
+    *
+    * @returns: true if they were in different sets
+    */
+  bool merge(int a, int b, int when) {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+      return false;
+
+    if (rank[a] < rank[b])
+      std::swap(a, b);
+    if (rank[a] == rank[b])
+      ++rank[a];
+
+    parent[b] = a;
+    year[a] = std::max(std::max(year[a], year[b]), when);
+    return true;
+  }
+
+  /** Last year the set with the given representative grew */
+  int getYear(int root) const { return year[root]; }
+};
+
+#endif // UNIONFIND_HPP
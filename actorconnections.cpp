@@ -12,45 +12,60 @@
 #include <fstream>
 #include <sstream>
 #include "ActorGraph.hpp"
+#include "ResultWriter.hpp"
 
-/** Performs a BFS traversal per year looking for actor connections
+/** Performs windowed BFS traversals looking for actor connections
   *
-  * @params: 2 ActorNode pointer: start & end, ofstream reference
+  * @params: 2 ActorNode pointer: start & end, ResultWriter reference
   */
-void BFS(ActorNode* start, ActorNode* end, ofstream& out);
-/** Performs a UnionFind implemented using a hash map. 
+void BFS(ActorNode* start, ActorNode* end, ResultWriter& out);
+/** Joins the casts of the movies year by year in a UnionFind
+  * until both actors end up in the same set.
   *
-  * @params: 2 ActorNode pointer: start & end, ofstream reference
+  * @params: 2 ActorNode pointer: start & end, ResultWriter reference
   */
-void UnionFind(ActorNode* start, ActorNode* end, ofstream& out);
-/** Builds the edges from the list of movies it is given.
-  * List is based of the years.
-  *
-  * @params: vector of Movie pointers
-  */
-void buildEdges(std::vector<Movie*> movies);
-/** Helper function used to reset all the edges on the actors
-  *
-  * @params: hash map of the Actors found in map
-  */
-void resetEdges(std::unordered_map<std::string, ActorNode*> actors);
+void UFind(ActorNode* start, ActorNode* end, ResultWriter& out);
 
 // Create an ActorGraph object
 ActorGraph* network = new ActorGraph();
 std::unordered_set<ActorNode*> actorPool;
 
+// Only movies released in [fromYear, toYear] are used
+int fromYear = INT_MIN;
+int toYear = INT_MAX;
+
 int main(int argc, char* argv[]) {
 
+  // A window needs both of its years
+  if (argc == 6) {
+    cerr << "Usage: ./actorconnections movie_cast_file.tsv pair_file.tsv output_file.tsv bfs|ufind [fromYear toYear]\n";
+    return -1;
+  }
+
   // We first load all the actors & movies from the provided file
   auto success = network->loadFromFile(argv[1], false);
   auto actors = network->getActorsMap();
   bool have_header = false;
 
   ifstream ifs(argv[2]);
-  ofstream ofs(argv[3]);
+  // Results are buffered & written by a separate I/O thread
+  ResultWriter ofs(argv[3]);
+  if (!ofs.isOpen()) {
+    cerr << "Failed to open " << argv[3] << "!\n";
+    return -1;
+  }
   string option = argv[4];
+
+  if (argc > 6) {
+    fromYear = stoi(argv[5]);
+    toYear = stoi(argv[6]);
+  }
+
+  // The BFS mode searches the full graph, restricted to a window of years
+  if (option.compare("bfs") == 0)
+    network->buildActorEdges();
   // Actor1<TAB>Actor2<TAB>Year
-  ofs << "Actor1" << "\t" << "Actor2" << "\t" << "Year" << endl;
+  ofs << "Actor1" << "\t" << "Actor2" << "\t" << "Year" << '\n';
 
   // Read while their is lines to be read
   while(ifs) {
@@ -78,10 +93,10 @@ int main(int argc, char* argv[]) {
     string actor1(record[0]);
     string actor2(record[1]);
 
-    resetEdges(actors);
-
-    if (actors.find(actor1) == actors.end() || actors.find(actor2) == actors.end()) {
-      ofs << actor1 << "\t" << actor2 << "\t" << "9999" << endl;
+    // Actors in different components are never connected
+    if (actors.find(actor1) == actors.end() || actors.find(actor2) == actors.end() ||
+        actors[actor1]->component != actors[actor2]->component) {
+      ofs << actor1 << "\t" << actor2 << "\t" << "9999" << '\n';
       continue;
     }
 
@@ -91,117 +106,33 @@ int main(int argc, char* argv[]) {
 
     // if union-find
     else if (option.compare("ufind") == 0)
-      UnionFind(actors[actor1], actors[actor2], ofs);
+      UFind(actors[actor1], actors[actor2], ofs);
   }
 
-  // Close & flush streams.
-  ofs.close();
-  ofs.flush();
+  // Close streams, writing what is left
+  bool written = ofs.close();
   ifs.close();
+  if (!written)
+    return -1;
 
   return 1;
 }
 
-void BFS(ActorNode* start, ActorNode* end, ofstream& out) {
-  // Set flag to false initially
-  bool found = false;
-
-  // We now have a forest of actors & movies (ordered by year)
-  for (auto& year: network->getMovieByYear()) {
-    // Build edges for specific given year.
-    buildEdges(year.second);
-
-    // So now that I have a pool of edges, run the actual BFS algorithm to find connection.
-    network->BFS(start);
-
-    // After running BFS, I now have all POSSIBLE paths from start to all nodes.
-    auto curr = end;
-
-    while(curr->prev != NULL) {
-      curr = curr->prev;
-    }
-
-    if (curr == start) {
-      out << start->actorName << "\t" << end->actorName << "\t" << year.first << endl;
-      found = true;
-      return;
-    }
-  }
+void BFS(ActorNode* start, ActorNode* end, ResultWriter& out) {
+  // Binary search for the first year whose window connects them
+  int year = network->connectedYear(start, end, fromYear, toYear);
 
-  if (!found)
-    out << start->actorName << "\t" << end->actorName << "\t" << "9999" << endl;
+  if (year != -1)
+    out << start->actorName << "\t" << end->actorName << "\t" << year << '\n';
+  else
+    out << start->actorName << "\t" << end->actorName << "\t" << "9999" << '\n';
 }
 
-void buildEdges(std::vector<Movie*> movies) {
-  ActorEdge* newEdge;
-
-  // Access every movie in vector
-  for (auto& movie : movies) {
-    // For each movie, access every actor
-    for (auto& actor : movie->cast) {
-      for (auto& otherActor : movie->cast) {
-        newEdge = new ActorEdge(movie, actor.second, otherActor.second);
-        actor.second->adjacencyList.push_back(newEdge);
-      }
-    }
-  }
-}
+void UFind(ActorNode* start, ActorNode* end, ResultWriter& out) {
+  int year = network->unionFindYear(start, end, fromYear, toYear);
 
-void resetEdges(std::unordered_map<std::string, ActorNode*> actors) {
-  for (auto& actor : actors)
-    actor.second->adjacencyList.clear();
+  if (year != -1)
+    out << start->actorName << "\t" << end->actorName << "\t" << year << '\n';
+  else
+    out << start->actorName << "\t" << end->actorName << "\t" << "9999" << '\n';
 }
-
-void UnionFind(ActorNode* start, ActorNode* end, ofstream& out) {
-  // Make a set(map) for the movie
-  std::unordered_map<std::string, ActorNode*> actorsUnion;
-
-  bool found = false;
-
-  // So we have movies for the specific year.
-  for (auto& year: network->getMovieByYear()) {
-    // Now access each movie in year
-    for (auto& movie : year.second) {
-      // Now add all the actors to the set
-      for (auto& actor : movie->cast)
-        actorsUnion.insert(actor);
-
-      // So now the set has all possible actors, now union them.
-      auto curr = *(actorsUnion.begin());
-
-      for (auto& actor : actorsUnion) {
-        if ((curr.second->rank) < (actor.second->rank)) {
-          actorsUnion[curr.second->actorName] = actor.second;
-          (actor.second->rank)++;
-          curr.second = actor.second;
-        }
-        else if ((actor.second->rank) < (curr.second->rank)) {
-          actorsUnion[actor.second->actorName] = curr.second;
-          (curr.second->rank)++;
-        }
-        else if (actor.second->actorName == curr.second->actorName) {
-          continue;
-        }
-        else {
-          actorsUnion[actor.second->actorName] = curr.second;
-          (curr.second->rank)++;
-        }
-      }
-    }
-
-    // Now that we have unioned all the movies in the year. Check if both actors are connected
-    if (actorsUnion.find(start->actorName) == actorsUnion.end() ||
-        actorsUnion.find(end->actorName) == actorsUnion.end()) {
-      continue;
-    }
-
-    if (actorsUnion[start->actorName] == actorsUnion[end->actorName]) {
-      out << start->actorName << "\t" << end->actorName << "\t" << year.first << endl;
-      found = true;
-      return;
-    }
-  }
-  if (!found)
-    out << start->actorName << "\t" << end->actorName << "\t" << "9999" << endl;
-
-}
\ No newline at end of file
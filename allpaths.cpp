@@ -0,0 +1,120 @@
+/*
+ * allpaths.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This program finds every shortest path between pairs
+ * of actors instead of the single one pathfinder prints.
+ * For each pair it writes how many shortest paths exist,
+ * followed by at most K of them (either the first K found
+ * or K distinct ones picked at random when sampling),
+ * using the same (actor)--[movie#@year]-->(actor) format
+ * as pathfinder.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "PackedGraph.hpp"
+#include "PathEnumerator.hpp"
+
+using namespace std;
+
+// Draws allowed per sampled path, since sample() can repeat paths
+static const unsigned long SAMPLE_TRIES = 8;
+
+int main(int argc, char* argv[]) {
+
+  if (argc < 6) {
+    cerr << "Usage: " << argv[0]
+         << " movie_casts.tsv u|w test_pairs.tsv out_paths.tsv K [sample]" << endl;
+    return 1;
+  }
+
+  string option = argv[2];
+  ifstream ifs(argv[3]);
+  ofstream ofs(argv[4]);
+  unsigned long limit = stoul(argv[5]);
+  bool sampling = (argc > 6 && string(argv[6]) == "sample");
+  bool have_header = false;
+
+  // Fixed seed so sampled output can be reproduced
+  mt19937_64 rng(2016);
+
+  // Load info from provided filename
+  PackedGraph* network = new PackedGraph();
+  if (!network->loadFromFile(argv[1]))
+    return 1;
+
+  PathEnumerator paths(*network);
+
+  // Print header to output file
+  ofs << "(actor)--[movie#@year]-->(actor)--..." << "\n";
+
+  // Read while their is lines to be read
+  while(ifs) {
+    string s;
+    if(!getline(ifs, s)) break;
+
+    if (!have_header) {
+      have_header = true;
+      continue;
+    }
+
+    istringstream ss( s );
+    vector<string> record;
+    while ( ss ) {
+      string next;
+      if (!getline(ss, next, '\t')) break;
+      record.push_back(next);
+    }
+
+    if (record.size() != 2) {
+      // should have exactly 2 columns -> 2 actors
+      continue;
+    }
+
+    string actor1(record[0]);
+    string actor2(record[1]);
+
+    paths.compute(network->findActor(actor1), network->findActor(actor2),
+                  option.compare("w") == 0);
+
+    // Pair line: both actors, the number of paths & their length
+    ofs << "#\t" << actor1 << "\t" << actor2 << "\t" << paths.getPathCount()
+        << (paths.isCountSaturated() ? "+" : "") << "\t" << paths.getDistance() << "\n";
+
+    // Sampling only pays off when there are more than K paths
+    bool sample = sampling && paths.getPathCount() > limit;
+
+    vector<uint32_t> path;
+    set<vector<uint32_t>> printed;
+    unsigned long tries = 0;
+    for (unsigned long i = 0; i < limit; ++i) {
+      if (sample) {
+        // Redraw the paths already printed, within a bounded number of tries
+        bool fresh = false;
+        while (!fresh && tries < SAMPLE_TRIES * limit && paths.sample(path, rng)) {
+          ++tries;
+          fresh = printed.insert(path).second;
+        }
+        if (!fresh)
+          break;
+      }
+      else if (!paths.next(path))
+        break;
+
+      network->exportPath(path, ofs);
+      ofs << "\n";
+    }
+  }
+
+  // Close & flush streams.
+  ofs.close();
+  ifs.close();
+
+  return 0;
+}
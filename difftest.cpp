@@ -0,0 +1,1051 @@
+/*
+ * difftest.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * A differential test for the search engines. The
+ * reference implementations (ActorGraph's BFS, Dijkstra,
+ * connectedYear & unionFindYear, i.e. what pathfinder &
+ * actorconnections run) are checked side by side with the
+ * faster ones (PackedGraph, ContractionHierarchy,
+ * PathEnumerator & GraphAnalytics), & all of them against
+ * a naive oracle computed straight from the records of the
+ * file.
+ *
+ * For every pair of actors, with & without a window of
+ * years, the path lengths, weighted costs & connection
+ * years must agree, & every step of every path must print
+ * the movie the oracle expects: the latest shared movie,
+ * ties broken by title. Every shortest path is counted,
+ * enumerated & sampled. The connected components, the
+ * years they reached their final form, the articulation
+ * actors & the distances from every actor are compared too.
+ *
+ * The graphs are either a movie_cast file & random pairs of
+ * its actors, or small random graphs generated from fixed
+ * seeds, so every run checks the same cases. On a mismatch,
+ * the records are cut down to a minimal set that still
+ * fails, which is printed as a movie_cast file.
+ *
+ * To run: ./difftest [graphs] or
+ *         ./difftest movie_casts.tsv [pairs] [test_pairs.tsv]
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ActorGraph.hpp"
+#include "PackedGraph.hpp"
+#include "ContractionHierarchy.hpp"
+#include "GraphAnalytics.hpp"
+#include "PathEnumerator.hpp"
+
+// Where the records being checked are written for the loaders
+static const char* CASE_FILE = "difftest_case.tsv";
+
+// Shortest paths enumerated per query, & random ones drawn
+static const uint64_t ENUMERATED_PATHS = 1000;
+static const int SAMPLED_PATHS = 5;
+// Up to this many paths, every one of them must get sampled
+static const uint64_t FEW_PATHS = 8;
+
+struct Record {
+  std::string actor;
+  std::string movie;
+  int year;
+};
+
+struct Query {
+  std::string actor1;
+  std::string actor2;
+  int fromYear;
+  int toYear;
+};
+
+/** Reads the records of a movie_cast file (skipping the header) */
+std::vector<Record> readRecords(const char* filename) {
+  std::vector<Record> records;
+  ifstream ifs(filename);
+  bool have_header = false;
+
+  while (ifs) {
+    string s;
+    if (!getline(ifs, s)) break;
+
+    if (!have_header) {
+      have_header = true;
+      continue;
+    }
+
+    istringstream ss(s);
+    vector<string> record;
+    while (ss) {
+      string next;
+      if (!getline(ss, next, '\t')) break;
+      record.push_back(next);
+    }
+
+    if (record.size() != 3)
+      continue;
+
+    records.push_back(Record{record[0], record[1], stoi(record[2])});
+  }
+
+  return records;
+}
+
+/** Writes records in the movie_cast format */
+void writeRecords(const std::vector<Record>& records, ostream& out) {
+  out << "Actor/Actress\tMovie\tYear\n";
+  for (auto& record : records)
+    out << record.actor << "\t" << record.movie << "\t" << record.year << "\n";
+}
+
+/** Reads the pairs of a test_pairs file (skipping the header) */
+std::vector<Query> readPairs(const char* filename) {
+  std::vector<Query> queries;
+  ifstream ifs(filename);
+  string s;
+  getline(ifs, s);
+
+  while (getline(ifs, s)) {
+    size_t tab = s.find('\t');
+    if (tab != string::npos)
+      queries.push_back(Query{s.substr(0, tab), s.substr(tab + 1), INT_MIN, INT_MAX});
+  }
+  return queries;
+}
+
+/** Answers every query the slow, obvious way, straight from the
+  * records: actors & movies are nodes of a bipartite graph, & a
+  * step from an actor to another goes through a shared movie.
+  */
+class Oracle {
+public:
+  std::unordered_map<std::string, int> actorIds;
+  std::vector<std::string> movieTitles;
+  std::vector<int> movieYears;
+  std::vector<std::vector<int>> moviesOf;   // by actor
+  std::vector<std::vector<int>> castOf;     // by movie
+  std::vector<int> years;                   // distinct, ascending
+  // Co-stars of every actor & the weight of their latest shared
+  // movie, only built once paths are counted
+  mutable std::vector<std::map<int, long long>> steps;
+
+  Oracle(const std::vector<Record>& records) {
+    std::map<std::string, int> movieIds;
+    std::set<std::pair<int, int>> roles;
+
+    for (auto& record : records) {
+      if (!actorIds.count(record.actor)) {
+        int id = (int) actorIds.size();
+        actorIds[record.actor] = id;
+        moviesOf.push_back(std::vector<int>());
+      }
+
+      string key = record.movie + "\t" + to_string(record.year);
+      if (!movieIds.count(key)) {
+        movieIds[key] = (int) movieTitles.size();
+        movieTitles.push_back(record.movie);
+        movieYears.push_back(record.year);
+        castOf.push_back(std::vector<int>());
+      }
+
+      int actor = actorIds[record.actor];
+      int movie = movieIds[key];
+      if (roles.insert(std::make_pair(actor, movie)).second) {
+        moviesOf[actor].push_back(movie);
+        castOf[movie].push_back(actor);
+      }
+      years.push_back(record.year);
+    }
+
+    sort(years.begin(), years.end());
+    years.erase(unique(years.begin(), years.end()), years.end());
+  }
+
+  /** Fills steps from the casts of the movies */
+  void buildSteps() const {
+    steps.resize(actorCount());
+    for (size_t movie = 0; movie < movieTitles.size(); ++movie) {
+      long long weight = 1 + (2015 - movieYears[movie]);
+      for (int actor : castOf[movie]) {
+        for (int other : castOf[movie]) {
+          if (other == actor)
+            continue;
+          auto step = steps[actor].find(other);
+          if (step == steps[actor].end() || weight < step->second)
+            steps[actor][other] = weight;
+        }
+      }
+    }
+  }
+
+  int find(const std::string& name) const {
+    auto it = actorIds.find(name);
+    return (it == actorIds.end()) ? -1 : it->second;
+  }
+
+  int actorCount() const { return (int) moviesOf.size(); }
+
+  /** Fewest steps from a to every actor using the movies in [from,
+    * to], -1 for the actors not reached. The skip actor (if any) is
+    * never stepped on.
+    */
+  std::vector<int> distances(int a, int from, int to, int skip = -1) const {
+    std::vector<int> dist(actorCount(), -1);
+    std::vector<bool> used(movieTitles.size(), false);
+    std::queue<int> toExplore;
+    dist[a] = 0;
+    toExplore.push(a);
+
+    while (!toExplore.empty()) {
+      int curr = toExplore.front();
+      toExplore.pop();
+
+      for (int movie : moviesOf[curr]) {
+        if (used[movie] || movieYears[movie] < from || movieYears[movie] > to)
+          continue;
+        used[movie] = true;
+
+        for (int actor : castOf[movie]) {
+          if (dist[actor] == -1 && actor != skip) {
+            dist[actor] = dist[curr] + 1;
+            toExplore.push(actor);
+          }
+        }
+      }
+    }
+    return dist;
+  }
+
+  /** Fewest steps from a to b using the movies in [from, to], -1 if
+    * none. The skip actor (if any) is never stepped on.
+    */
+  int hops(int a, int b, int from, int to, int skip = -1) const {
+    return distances(a, from, to, skip)[b];
+  }
+
+  /** Cheapest path from a to b, a step through a movie costing
+    * 1 + (2015 - year), -1 if none. Reaching a movie costs its
+    * weight, leaving it to any of its cast is free.
+    */
+  long long cost(int a, int b, int from, int to) const {
+    int actors = actorCount();
+    std::vector<long long> dist(actors + movieTitles.size(), -1);
+    typedef std::pair<long long, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    dist[a] = 0;
+    pq.push(Entry(0, a));
+
+    while (!pq.empty()) {
+      Entry top = pq.top();
+      pq.pop();
+      if (top.first != dist[top.second])
+        continue;
+
+      if (top.second < actors) {
+        for (int movie : moviesOf[top.second]) {
+          if (movieYears[movie] < from || movieYears[movie] > to)
+            continue;
+          long long next = top.first + 1 + (2015 - movieYears[movie]);
+          if (dist[actors + movie] == -1 || next < dist[actors + movie]) {
+            dist[actors + movie] = next;
+            pq.push(Entry(next, actors + movie));
+          }
+        }
+      }
+      else {
+        for (int actor : castOf[top.second - actors]) {
+          if (dist[actor] == -1 || top.first < dist[actor]) {
+            dist[actor] = top.first;
+            pq.push(Entry(top.first, actor));
+          }
+        }
+      }
+    }
+    return dist[b];
+  }
+
+  /** Number of shortest paths from a to b, 0 if none. Paths are
+    * told apart by their actors: two actors sharing several movies
+    * make one step, through their cheapest movie when weighted.
+    */
+  uint64_t pathCount(int a, int b, bool weighted) const {
+    if (steps.empty())
+      buildSteps();
+
+    std::vector<long long> dist(actorCount(), -1);
+    typedef std::pair<long long, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    dist[a] = 0;
+    pq.push(Entry(0, a));
+
+    while (!pq.empty()) {
+      Entry top = pq.top();
+      pq.pop();
+      if (top.first != dist[top.second])
+        continue;
+
+      for (auto& step : steps[top.second]) {
+        long long next = top.first + (weighted ? step.second : 1);
+        if (dist[step.first] == -1 || next < dist[step.first]) {
+          dist[step.first] = next;
+          pq.push(Entry(next, step.first));
+        }
+      }
+    }
+
+    // Every step adds at least 1, so by increasing distance every
+    // actor's count is final before it is passed on
+    std::vector<int> order;
+    for (int actor = 0; actor < actorCount(); ++actor) {
+      if (dist[actor] != -1)
+        order.push_back(actor);
+    }
+    sort(order.begin(), order.end(), [&dist](int x, int y) { return dist[x] < dist[y]; });
+
+    std::vector<uint64_t> count(actorCount(), 0);
+    count[a] = 1;
+    for (int actor : order) {
+      for (auto& step : steps[actor]) {
+        if (step.first != a && dist[actor] + (weighted ? step.second : 1) == dist[step.first])
+          count[step.first] = (count[step.first] > UINT64_MAX - count[actor])
+                                ? UINT64_MAX : count[step.first] + count[actor];
+      }
+    }
+    return count[b];
+  }
+
+  /** The movie printed between a & b: the latest one they share in
+    * [from, to], ties broken by title. -1 if they share none.
+    */
+  int commonMovie(int a, int b, int from, int to) const {
+    int best = -1;
+    for (int movie : moviesOf[a]) {
+      if (movieYears[movie] < from || movieYears[movie] > to)
+        continue;
+      if (std::find(castOf[movie].begin(), castOf[movie].end(), b) == castOf[movie].end())
+        continue;
+
+      if (best == -1 || movieYears[movie] > movieYears[best] ||
+          (movieYears[movie] == movieYears[best] && movieTitles[movie] < movieTitles[best]))
+        best = movie;
+    }
+    return best;
+  }
+
+  /** First year y such that the movies in [from, y] connect a & b */
+  int connectedYear(int a, int b, int from, int to) const {
+    if (hops(a, b, from, to) == -1)
+      return -1;
+
+    for (int year : years) {
+      if (year >= from && year <= to && hops(a, b, from, year) != -1)
+        return year;
+    }
+    return -1;
+  }
+
+  /** Component of every actor, numbered in order of first member */
+  std::vector<int> components() const {
+    std::vector<int> component(actorCount(), -1);
+    int count = 0;
+    for (int actor = 0; actor < actorCount(); ++actor) {
+      if (component[actor] != -1)
+        continue;
+      std::vector<int> dist = distances(actor, INT_MIN, INT_MAX);
+      for (int other = 0; other < actorCount(); ++other) {
+        if (dist[other] != -1)
+          component[other] = count;
+      }
+      ++count;
+    }
+    return component;
+  }
+
+  /** true if taking actor out disconnects two others of its component */
+  bool isArticulation(int actor, const std::vector<int>& component) const {
+    int first = -1;
+    for (int other = 0; other < actorCount() && first == -1; ++other) {
+      if (other != actor && component[other] == component[actor])
+        first = other;
+    }
+    if (first == -1)
+      return false;
+
+    // Every other member must still be reachable from the first one
+    std::vector<int> dist = distances(first, INT_MIN, INT_MAX, actor);
+    for (int other = 0; other < actorCount(); ++other) {
+      if (other != actor && component[other] == component[actor] && dist[other] == -1)
+        return true;
+    }
+    return false;
+  }
+
+  /** First year the movies up to it connect every member of each
+    * component to each other (its final form), by component.
+    */
+  std::vector<int> componentYears(const std::vector<int>& component) const {
+    int count = component.empty() ? 0 : *max_element(component.begin(), component.end()) + 1;
+    std::vector<int> result(count, -1);
+
+    for (int c = 0; c < count; ++c) {
+      int actor = (int) (std::find(component.begin(), component.end(), c) - component.begin());
+      int firstYear = INT_MAX;
+      for (int movie : moviesOf[actor])
+        firstYear = min(firstYear, movieYears[movie]);
+
+      // The actor has to show up before anyone can be reached
+      for (int year : years) {
+        if (year < firstYear)
+          continue;
+
+        std::vector<int> dist = distances(actor, INT_MIN, year);
+        bool complete = true;
+        for (int other = 0; other < actorCount() && complete; ++other) {
+          if (component[other] == c && dist[other] == -1)
+            complete = false;
+        }
+        if (complete) {
+          result[c] = year;
+          break;
+        }
+      }
+    }
+    return result;
+  }
+};
+
+/** Every engine, loaded from the same records */
+class Engines {
+public:
+  Oracle oracle;
+  ActorGraph reference;
+  unordered_map<string, ActorNode*> actors;
+  PackedGraph packed;
+  ContractionHierarchy hierarchy;
+  // Sized for the graph, so only made once it is loaded
+  PathEnumerator* enumerator;
+
+  Engines(const std::vector<Record>& records) : oracle(records), hierarchy(packed) {
+    ofstream ofs(CASE_FILE);
+    writeRecords(records, ofs);
+    ofs.close();
+
+    reference.loadFromFile(CASE_FILE, false);
+    reference.buildActorEdges();
+    actors = reference.getActorsMap();
+
+    packed.loadFromFile(CASE_FILE);
+    hierarchy.build();
+    enumerator = new PathEnumerator(packed);
+    remove(CASE_FILE);
+  }
+
+  ~Engines() { delete enumerator; }
+};
+
+/** Prints a query the way mismatches are reported */
+string describe(const Query& query) {
+  ostringstream out;
+  out << "(" << query.actor1 << ") -> (" << query.actor2 << ")";
+  if (query.fromYear != INT_MIN || query.toYear != INT_MAX)
+    out << " in [" << query.fromYear << ", " << query.toYear << "]";
+  return out.str();
+}
+
+/** Compares the movie picked for a step with the oracle's choice.
+  *
+  * @returns: "" if they agree, what went wrong otherwise
+  */
+string checkStep(const Oracle& oracle, const string& actor1, const string& actor2,
+                 const string& title, int year, int from, int to) {
+  int movie = oracle.commonMovie(oracle.find(actor1), oracle.find(actor2), from, to);
+  if (movie == -1)
+    return "(" + actor1 + ") & (" + actor2 + ") share no movie, but a path uses " +
+           title + "#@" + to_string(year);
+  if (oracle.movieTitles[movie] != title || oracle.movieYears[movie] != year)
+    return "step (" + actor1 + ")-(" + actor2 + ") prints " + title + "#@" + to_string(year) +
+           " instead of " + oracle.movieTitles[movie] + "#@" + to_string(oracle.movieYears[movie]);
+  return "";
+}
+
+/** Checks an ActorGraph path (left in prev by the last search).
+  *
+  * @returns: "" if it is fine, what went wrong otherwise
+  */
+string checkReferencePath(Engines& engines, ActorNode* start, ActorNode* end, const Query& query,
+                          const string& engine, long long expected, bool weighted) {
+  if (end != start && end->prev == NULL)
+    return (expected == -1) ? "" : engine + " finds no path, expected " + to_string(expected);
+  if (expected == -1)
+    return engine + " finds a path, expected none";
+
+  std::vector<ActorNode*> path;
+  for (ActorNode* actor = end; actor != NULL; actor = actor->prev)
+    path.push_back(actor);
+  if (path.back() != start)
+    return engine + " path does not start at the first actor";
+
+  long long length = 0;
+  for (size_t i = path.size() - 1; i > 0; --i) {
+    Movie* movie = engines.reference.findCommonMovie(path[i - 1], path[i]);
+    string error = checkStep(engines.oracle, path[i]->actorName, path[i - 1]->actorName,
+                             movie->name, movie->date, query.fromYear, query.toYear);
+    if (!error.empty())
+      return engine + " " + error;
+    length += weighted ? 1 + (2015 - movie->date) : 1;
+  }
+
+  if (length != expected)
+    return engine + " path has length " + to_string(length) + ", expected " + to_string(expected);
+  return "";
+}
+
+/** Checks a PackedGraph path given as actor IDs & (optionally) the
+  * movie of every step.
+  *
+  * @returns: "" if it is fine, what went wrong otherwise
+  */
+string checkPackedPath(Engines& engines, const std::vector<uint32_t>& path,
+                       const std::vector<uint32_t>* movies, uint32_t start, uint32_t end,
+                       const string& engine, long long expected, bool weighted) {
+  const PackedGraph& packed = engines.packed;
+  if (path.empty() || path.front() != start || path.back() != end)
+    return engine + " path does not join the two actors";
+
+  long long length = 0;
+  for (size_t i = 1; i < path.size(); ++i) {
+    uint32_t movie = movies ? (*movies)[i - 1] : packed.findCommonMovie(path[i - 1], path[i]);
+    if (movie == PackedGraph::NO_ACTOR)
+      return engine + " path steps between actors without a shared movie";
+
+    string error = checkStep(engines.oracle, packed.actorName(path[i - 1]), packed.actorName(path[i]),
+                             packed.movieName(movie), packed.movieYear(movie), INT_MIN, INT_MAX);
+    if (!error.empty())
+      return engine + " " + error;
+    length += weighted ? 1 + (2015 - packed.movieYear(movie)) : 1;
+  }
+
+  if (length != expected)
+    return engine + " path has length " + to_string(length) + ", expected " + to_string(expected);
+  return "";
+}
+
+/** Follows prev from end back to the start of the last PackedGraph search */
+std::vector<uint32_t> packedPath(const PackedGraph& packed, uint32_t end) {
+  std::vector<uint32_t> path;
+  for (uint32_t curr = end; curr != PackedGraph::NO_ACTOR; curr = packed.prev[curr])
+    path.push_back(curr);
+  reverse(path.begin(), path.end());
+  return path;
+}
+
+/** Checks every shortest path PathEnumerator gives for a pair: their
+  * number, that enumerating them yields that many distinct paths
+  * (up to ENUMERATED_PATHS), & that random ones are among them (all
+  * of them turning up when there are only a few).
+  *
+  * @returns: "" if it is fine, what went wrong otherwise
+  */
+string checkEnumerator(Engines& engines, uint32_t p1, uint32_t p2, bool weighted,
+                       long long expected, uint64_t expectedCount) {
+  PathEnumerator& enumerator = *engines.enumerator;
+  string engine = weighted ? "PathEnumerator (weighted)" : "PathEnumerator (unweighted)";
+
+  bool found = enumerator.compute(p1, p2, weighted);
+  long long distance = found ? enumerator.getDistance() : -1;
+  if (distance != expected)
+    return engine + " distance " + to_string(distance) + ", expected " + to_string(expected);
+
+  uint64_t count = enumerator.getPathCount();
+  if (count != expectedCount)
+    return engine + " counts " + to_string(count) + " paths, expected " + to_string(expectedCount);
+
+  std::set<std::vector<uint32_t>> enumerated;
+  std::vector<uint32_t> path;
+  while (enumerated.size() < ENUMERATED_PATHS && enumerator.next(path)) {
+    string error = checkPackedPath(engines, path, NULL, p1, p2, engine, expected, weighted);
+    if (!error.empty())
+      return error;
+    if (!enumerated.insert(path).second)
+      return engine + " enumerates the same path twice";
+  }
+
+  // All of them when there are few, otherwise at least the limit
+  bool complete = (count <= ENUMERATED_PATHS);
+  bool more = enumerator.next(path);
+  if (complete ? (enumerated.size() != count || more) : enumerated.size() != ENUMERATED_PATHS)
+    return engine + " enumerates " + (more ? "over " : "") + to_string(enumerated.size()) +
+           " paths, but counts " + to_string(count);
+
+  // With few paths, draw enough that each is all but sure to turn up
+  bool few = (count <= FEW_PATHS);
+  int draws = few ? 20 * (int) count : SAMPLED_PATHS;
+  std::set<std::vector<uint32_t>> sampled;
+
+  // Fixed seed, so a failing sample shows up on every run
+  std::mt19937_64 rng(p1 * 31 + p2);
+  for (int i = 0; i < max(draws, 1); ++i) {
+    if (enumerator.sample(path, rng) != found)
+      return found ? engine + " samples no path" : engine + " samples a path, expected none";
+    if (!found)
+      break;
+
+    string error = checkPackedPath(engines, path, NULL, p1, p2, engine + " sample", expected, weighted);
+    if (!error.empty())
+      return error;
+    if (complete && !enumerated.count(path))
+      return engine + " samples a path it does not enumerate";
+    sampled.insert(path);
+  }
+
+  if (few && sampled.size() != count)
+    return engine + " never samples " + to_string(count - sampled.size()) + " of its " +
+           to_string(count) + " paths";
+  return "";
+}
+
+/** Runs one query through every engine.
+  *
+  * @returns: "" if they all agree with the oracle, the first
+  *           disagreement otherwise
+  */
+string checkQuery(Engines& engines, const Query& query) {
+  Oracle& oracle = engines.oracle;
+  int from = query.fromYear, to = query.toYear;
+  bool windowed = (from != INT_MIN || to != INT_MAX);
+
+  int o1 = oracle.find(query.actor1), o2 = oracle.find(query.actor2);
+  auto r1 = engines.actors.find(query.actor1), r2 = engines.actors.find(query.actor2);
+  uint32_t p1 = engines.packed.findActor(query.actor1), p2 = engines.packed.findActor(query.actor2);
+
+  // Unknown actors must be unknown to everyone
+  bool known = (o1 != -1 && o2 != -1);
+  if ((r1 != engines.actors.end() && r2 != engines.actors.end()) != known)
+    return "ActorGraph disagrees on whether the actors exist";
+  if ((p1 != PackedGraph::NO_ACTOR && p2 != PackedGraph::NO_ACTOR) != known)
+    return "PackedGraph disagrees on whether the actors exist";
+  if (!known)
+    return "";
+
+  ActorNode* start = r1->second;
+  ActorNode* end = r2->second;
+  int hops = oracle.hops(o1, o2, from, to);
+  long long cost = oracle.cost(o1, o2, from, to);
+  string error;
+
+  /* Reference: pathfinder's searches (no search across components) */
+  bool sameComponent = (start->component == end->component);
+  if (sameComponent != (oracle.hops(o1, o2, INT_MIN, INT_MAX) != -1))
+    return "ActorGraph components disagree on whether the actors are connected";
+
+  if (sameComponent) {
+    engines.reference.BFS(start, from, to);
+    error = checkReferencePath(engines, start, end, query, "ActorGraph::BFS", hops, false);
+    if (!error.empty())
+      return error;
+
+    engines.reference.Dijkstra(start, from, to);
+    error = checkReferencePath(engines, start, end, query, "ActorGraph::Dijkstra", cost, true);
+    if (!error.empty())
+      return error;
+  }
+
+  /* Reference: actorconnections' two modes (an actor is trivially
+     connected to itself, so those are left out) */
+  if (start != end) {
+    int year = oracle.connectedYear(o1, o2, from, to);
+    int bfsYear = engines.reference.connectedYear(start, end, from, to);
+    if (bfsYear != year)
+      return "ActorGraph::connectedYear gives " + to_string(bfsYear) + ", expected " + to_string(year);
+
+    int ufindYear = engines.reference.unionFindYear(start, end, from, to);
+    if (ufindYear != year)
+      return "ActorGraph::unionFindYear gives " + to_string(ufindYear) + ", expected " + to_string(year);
+  }
+
+  // The packed engines do not take windows
+  if (windowed)
+    return "";
+
+  PackedGraph& packed = engines.packed;
+  if ((packed.getComponent(p1) == packed.getComponent(p2)) != sameComponent)
+    return "PackedGraph components disagree on whether the actors are connected";
+
+  if (sameComponent) {
+    packed.BFS(p1);
+    if (packed.dist[p2] != hops)
+      return "PackedGraph::BFS distance " + to_string(packed.dist[p2]) + ", expected " + to_string(hops);
+    error = checkPackedPath(engines, packedPath(packed, p2), NULL, p1, p2, "PackedGraph::BFS", hops, false);
+    if (!error.empty())
+      return error;
+
+    packed.Dijkstra(p1);
+    if (packed.dist[p2] != cost)
+      return "PackedGraph::Dijkstra distance " + to_string(packed.dist[p2]) + ", expected " + to_string(cost);
+    error = checkPackedPath(engines, packedPath(packed, p2), NULL, p1, p2, "PackedGraph::Dijkstra", cost, true);
+    if (!error.empty())
+      return error;
+  }
+
+  std::vector<uint32_t> path, movies;
+  int hierarchyCost = engines.hierarchy.query(p1, p2, path, movies);
+  if (hierarchyCost != cost)
+    return "ContractionHierarchy distance " + to_string(hierarchyCost) + ", expected " + to_string(cost);
+  if (cost != -1) {
+    error = checkPackedPath(engines, path, &movies, p1, p2, "ContractionHierarchy", cost, true);
+    if (!error.empty())
+      return error;
+  }
+
+  for (int weighted = 0; weighted < 2; ++weighted) {
+    error = checkEnumerator(engines, p1, p2, weighted, weighted ? cost : hops,
+                            oracle.pathCount(o1, o2, weighted));
+    if (!error.empty())
+      return error;
+  }
+
+  return "";
+}
+
+/** Compares the components of every actor & the year each component
+  * reached its final form.
+  *
+  * @returns: "" if they all agree with the oracle, the first
+  *           disagreement otherwise
+  */
+string checkComponents(Engines& engines) {
+  Oracle& oracle = engines.oracle;
+  std::vector<int> component = oracle.components();
+  std::vector<int> componentYears = oracle.componentYears(component);
+
+  // Both labelings must split the actors the same way as the oracle
+  std::map<int, int> referenceLabel, packedLabel;
+  for (auto& actor : oracle.actorIds) {
+    int expected = component[actor.second];
+    int reference = engines.actors[actor.first]->component;
+    int packed = (int) engines.packed.getComponent(engines.packed.findActor(actor.first));
+
+    if (!referenceLabel.count(reference))
+      referenceLabel[reference] = expected;
+    if (!packedLabel.count(packed))
+      packedLabel[packed] = expected;
+    if (referenceLabel[reference] != expected)
+      return "ActorGraph puts (" + actor.first + ") in the wrong component";
+    if (packedLabel[packed] != expected)
+      return "PackedGraph puts (" + actor.first + ") in the wrong component";
+
+    uint32_t id = engines.packed.findActor(actor.first);
+    if (engines.packed.isArticulation(id) != oracle.isArticulation(actor.second, component))
+      return engines.packed.isArticulation(id)
+               ? "PackedGraph marks (" + actor.first + ") as an articulation actor, expected not"
+               : "PackedGraph misses articulation actor (" + actor.first + ")";
+
+    int year = componentYears[expected];
+    if (engines.reference.getComponentYear(reference) != year)
+      return "ActorGraph: the component of (" + actor.first + ") is complete in " +
+             to_string(engines.reference.getComponentYear(reference)) + ", expected " + to_string(year);
+    if (engines.packed.getComponentYear(packed) != year)
+      return "PackedGraph: the component of (" + actor.first + ") is complete in " +
+             to_string(engines.packed.getComponentYear(packed)) + ", expected " + to_string(year);
+  }
+
+  if ((int) referenceLabel.size() != engines.reference.getComponentCount())
+    return "ActorGraph has empty components";
+  if (referenceLabel.size() != engines.packed.getComponentCount())
+    return "PackedGraph has empty components";
+  return "";
+}
+
+/** Runs GraphAnalytics' bit-parallel BFS from every actor & compares
+  * each source's eccentricity, distance sum & actors reached, & the
+  * distance histogram, with a plain BFS per source. Sources are taken
+  * in ID order (so batches mix components) over two threads.
+  *
+  * @returns: "" if they all agree with the oracle, the first
+  *           disagreement otherwise
+  */
+string checkAnalytics(Engines& engines) {
+  Oracle& oracle = engines.oracle;
+  PackedGraph& packed = engines.packed;
+  GraphAnalytics analytics(packed);
+
+  std::vector<uint32_t> sources(packed.getActorCount());
+  for (uint32_t actor = 0; actor < sources.size(); ++actor)
+    sources[actor] = actor;
+  analytics.run(sources, 2);
+
+  std::vector<uint64_t> histogram(1, sources.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    const string& name = packed.actorName(sources[i]);
+    std::vector<int> dist = oracle.distances(oracle.find(name), INT_MIN, INT_MAX);
+
+    int eccentricity = 0;
+    uint64_t distanceSum = 0;
+    uint32_t reached = 0;
+    for (int d : dist) {
+      if (d <= 0)
+        continue;
+      eccentricity = max(eccentricity, d);
+      distanceSum += d;
+      ++reached;
+      if (histogram.size() <= (size_t) d)
+        histogram.resize(d + 1, 0);
+      ++histogram[d];
+    }
+
+    if (analytics.eccentricity[i] != eccentricity)
+      return "GraphAnalytics: eccentricity of (" + name + ") is " +
+             to_string(analytics.eccentricity[i]) + ", expected " + to_string(eccentricity);
+    if (analytics.distanceSum[i] != distanceSum)
+      return "GraphAnalytics: distance sum of (" + name + ") is " +
+             to_string(analytics.distanceSum[i]) + ", expected " + to_string(distanceSum);
+    if (analytics.reached[i] != reached)
+      return "GraphAnalytics: (" + name + ") reaches " + to_string(analytics.reached[i]) +
+             " actors, expected " + to_string(reached);
+  }
+
+  if (analytics.distanceHistogram != histogram)
+    return "GraphAnalytics: the distance histogram differs";
+  return "";
+}
+
+/** Cuts records down to a small set that still fails: first to the
+  * movies of the given actor's component, then by removing chunks of
+  * records (delta debugging) until no single record can go.
+  *
+  * @params: records, fails - true if a set of records still fails,
+  *          actor - name to narrow down to ("" for none)
+  * @returns: the minimized records
+  */
+std::vector<Record> minimize(std::vector<Record> records,
+                             const std::function<bool(const std::vector<Record>&)>& fails,
+                             const string& actor) {
+  if (!actor.empty()) {
+    Oracle oracle(records);
+    int a = oracle.find(actor);
+    if (a != -1) {
+      std::vector<Record> component;
+      for (auto& record : records) {
+        int other = oracle.find(record.actor);
+        if (oracle.hops(a, other, INT_MIN, INT_MAX) != -1)
+          component.push_back(record);
+      }
+      if (component.size() < records.size() && fails(component))
+        records = component;
+    }
+  }
+
+  size_t chunks = 2;
+  while (records.size() >= 2) {
+    size_t size = (records.size() + chunks - 1) / chunks;
+    bool reduced = false;
+
+    for (size_t first = 0; first < records.size(); first += size) {
+      std::vector<Record> rest(records.begin(), records.begin() + first);
+      rest.insert(rest.end(), records.begin() + min(first + size, records.size()), records.end());
+
+      if (fails(rest)) {
+        records = rest;
+        chunks = max(chunks - 1, (size_t) 2);
+        reduced = true;
+        break;
+      }
+    }
+
+    if (!reduced) {
+      if (chunks >= records.size())
+        break;
+      chunks = min(records.size(), chunks * 2);
+    }
+  }
+
+  return records;
+}
+
+/** Runs the component check & every query over a set of records,
+  * printing the first mismatch along with a minimized input.
+  *
+  * @params: name - what the records are, records, queries,
+  *          components - also run the graph-wide checks (slow on large files)
+  * @returns: the number of mismatches
+  */
+int runCase(const string& name, const std::vector<Record>& records,
+            const std::vector<Query>& queries, bool components) {
+  Engines engines(records);
+  int mismatches = 0;
+  string first;
+  std::function<string(const std::vector<Record>&)> check;
+  string narrowTo;
+
+  if (components) {
+    for (auto graphCheck : {checkComponents, checkAnalytics}) {
+      string error = graphCheck(engines);
+      if (error.empty() || mismatches++ > 0)
+        continue;
+
+      first = error;
+      check = [graphCheck](const std::vector<Record>& subset) {
+        Engines subsetEngines(subset);
+        return graphCheck(subsetEngines);
+      };
+    }
+  }
+
+  for (auto& query : queries) {
+    string error = checkQuery(engines, query);
+    if (error.empty())
+      continue;
+
+    if (mismatches++ == 0) {
+      first = describe(query) + ": " + error;
+      narrowTo = query.actor1;
+      check = [query](const std::vector<Record>& subset) {
+        Engines subsetEngines(subset);
+        string error = checkQuery(subsetEngines, query);
+        return error.empty() ? error : describe(query) + ": " + error;
+      };
+    }
+  }
+
+  if (mismatches == 0)
+    return 0;
+
+  cout << name << ": " << queries.size() << " queries, " << mismatches << " mismatches" << endl;
+
+  cout << "  " << first << endl;
+  auto fails = [&check](const std::vector<Record>& subset) { return !check(subset).empty(); };
+  std::vector<Record> minimal = minimize(records, fails, narrowTo);
+  cout << "  minimized input (" << minimal.size() << " records), failing with" << endl;
+  cout << "  " << check(minimal) << endl;
+  writeRecords(minimal, cout);
+  cout << endl;
+  return mismatches;
+}
+
+/** Windows of years to try a query with, taken from the years
+  * the records actually use.
+  */
+std::vector<Query> withWindows(const Query& query, const std::vector<int>& years, std::mt19937& rng) {
+  std::vector<Query> queries(1, query);
+  if (years.empty())
+    return queries;
+
+  int from = years[rng() % years.size()];
+  int to = years[rng() % years.size()];
+  if (from > to)
+    std::swap(from, to);
+
+  queries.push_back(Query{query.actor1, query.actor2, from, to});
+  queries.push_back(Query{query.actor1, query.actor2, from, INT_MAX});
+  queries.push_back(Query{query.actor1, query.actor2, INT_MIN, to});
+  return queries;
+}
+
+/** Makes a small random graph: few years & recurring titles, so that
+  * ties between movies (same year, or same title) are common.
+  */
+std::vector<Record> randomRecords(std::mt19937& rng) {
+  int actorCount = 2 + rng() % 30;
+  int movieCount = 1 + rng() % 25;
+  int yearCount = 1 + rng() % 6;
+  int titleCount = 1 + rng() % movieCount;
+
+  std::vector<Record> records;
+  for (int movie = 0; movie < movieCount; ++movie) {
+    string title = "MOVIE " + string(1, (char) ('A' + rng() % titleCount));
+    int year = 2000 + (int) (rng() % yearCount);
+    int castSize = 1 + rng() % 5;
+
+    for (int role = 0; role < castSize; ++role) {
+      int actor = rng() % actorCount;
+      // Names that do not sort in creation order
+      string actorName = "ACTOR " + string(1, (char) ('Z' - actor % 26)) + to_string(actor);
+      records.push_back(Record{actorName, title, year});
+    }
+  }
+
+  shuffle(records.begin(), records.end(), rng);
+  return records;
+}
+
+int main(int argc, char* argv[]) {
+  int mismatches = 0;
+
+  // A movie_cast file: random pairs of its actors
+  if (argc > 1 && string(argv[1]).find(".tsv") != string::npos) {
+    std::vector<Record> records = readRecords(argv[1]);
+    int pairCount = (argc > 2) ? stoi(argv[2]) : 20;
+    std::mt19937 rng(2016);
+
+    Oracle oracle(records);
+    std::vector<string> names(oracle.actorIds.size());
+    for (auto& actor : oracle.actorIds)
+      names[actor.second] = actor.first;
+
+    std::vector<Query> pairs;
+    if (argc > 3)
+      pairs = readPairs(argv[3]);
+    for (int i = 0; i < pairCount && !names.empty(); ++i)
+      pairs.push_back(Query{names[rng() % names.size()], names[rng() % names.size()], INT_MIN, INT_MAX});
+
+    std::vector<Query> queries;
+    for (auto& pair : pairs) {
+      for (auto& query : withWindows(pair, oracle.years, rng))
+        queries.push_back(query);
+    }
+
+    // The naive graph-wide checks are quadratic, only small files get them
+    mismatches += runCase(argv[1], records, queries, records.size() < 10000);
+    if (mismatches == 0)
+      cout << argv[1] << ": " << queries.size() << " queries, 0 mismatches" << endl;
+  }
+
+  // Random graphs from fixed seeds
+  else {
+    int graphCount = (argc > 1) ? stoi(argv[1]) : 200;
+    size_t queryCount = 0;
+    for (int seed = 1; seed <= graphCount; ++seed) {
+      std::mt19937 rng(seed);
+      std::vector<Record> records = randomRecords(rng);
+      Oracle oracle(records);
+
+      std::vector<string> names(oracle.actorIds.size());
+      for (auto& actor : oracle.actorIds)
+        names[actor.second] = actor.first;
+      names.push_back("NOBODY");
+
+      // Every pair, each with a few windows
+      std::vector<Query> queries;
+      for (auto& actor1 : names) {
+        for (auto& actor2 : names) {
+          for (auto& query : withWindows(Query{actor1, actor2, INT_MIN, INT_MAX}, oracle.years, rng))
+            queries.push_back(query);
+        }
+      }
+
+      mismatches += runCase("random graph " + to_string(seed), records, queries, true);
+      queryCount += queries.size();
+      if (mismatches)
+        break;
+    }
+
+    if (mismatches == 0)
+      cout << graphCount << " random graphs: " << queryCount << " queries, 0 mismatches" << endl;
+  }
+
+  return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+/*
+ * graphanalytics.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This program computes graph-wide statistics: the
+ * eccentricity & closeness of every actor, the sizes of
+ * the connected components, the distribution of the
+ * distances between actors, the most central actor &
+ * the Bacon number of every actor. On huge graphs only
+ * a random sample of actors can be used as sources, which
+ * gives approximate results.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PackedGraph.hpp"
+#include "GraphAnalytics.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+
+  if (argc < 3) {
+    cerr << "Usage: " << argv[0]
+         << " movie_casts.tsv out_actors.tsv [threads] [samples] [actor]" << endl;
+    return 1;
+  }
+
+  ofstream ofs(argv[2]);
+  unsigned threads = (argc > 3) ? stoul(argv[3]) : thread::hardware_concurrency();
+  uint32_t samples = (argc > 4) ? stoul(argv[4]) : 0;
+  string baconName = (argc > 5) ? argv[5] : "BACON, KEVIN (I)";
+
+  // Load info from provided filename
+  PackedGraph* network = new PackedGraph();
+  if (!network->loadFromFile(argv[1]))
+    return 1;
+
+  GraphAnalytics analytics(*network);
+  analytics.computeComponents();
+  analytics.run(analytics.pickSources(samples, 2016), threads);
+
+  auto& sources = analytics.sources;
+  cout << "actors: " << network->getActorCount() << "\tedges: " << network->getEdgeCount()
+       << "\tsources: " << sources.size() << (sources.size() < network->getActorCount() ?
+          " (sampled, results are approximate)" : "") << "\n";
+
+  // Component sizes: size -> number of components that big
+  map<uint32_t, uint32_t> sizes;
+  for (auto size : analytics.componentSizes)
+    ++sizes[size];
+
+  cout << "components: " << analytics.componentSizes.size() << "\n";
+  cout << "component size\tcount\n";
+  for (auto it = sizes.rbegin(); it != sizes.rend(); ++it)
+    cout << it->first << "\t" << it->second << "\n";
+
+  // Distance distribution over every (source, reached actor) pair
+  uint64_t pairs = 0, total = 0;
+  cout << "distance\tpairs\n";
+  for (size_t d = 1; d < analytics.distanceHistogram.size(); ++d) {
+    cout << d << "\t" << analytics.distanceHistogram[d] << "\n";
+    pairs += analytics.distanceHistogram[d];
+    total += d * analytics.distanceHistogram[d];
+  }
+  if (pairs)
+    cout << "average distance: " << (double) total / pairs << "\n";
+  cout << "largest eccentricity: " << analytics.distanceHistogram.size() - 1 << "\n";
+
+  size_t center = analytics.findCenter();
+  if (center < sources.size()) {
+    cout << "center: " << network->actorName(sources[center])
+         << "\teccentricity: " << analytics.eccentricity[center]
+         << "\tcloseness: " << analytics.closeness(center) << "\n";
+  }
+
+  // Bacon numbers: one more BFS from the given actor
+  uint32_t bacon = network->findActor(baconName);
+  if (bacon != PackedGraph::NO_ACTOR) {
+    network->BFS(bacon);
+
+    vector<uint64_t> numbers;
+    uint64_t connected = 0, sum = 0;
+    for (auto d : network->dist) {
+      if (d <= 0)
+        continue;
+      if (numbers.size() <= (size_t) d)
+        numbers.resize(d + 1, 0);
+      ++numbers[d];
+      ++connected;
+      sum += d;
+    }
+
+    cout << baconName << " number\tactors\n";
+    for (size_t d = 1; d < numbers.size(); ++d)
+      cout << d << "\t" << numbers[d] << "\n";
+    if (connected)
+      cout << "average " << baconName << " number: " << (double) sum / connected << "\n";
+  }
+
+  // Actor<TAB>Component<TAB>Eccentricity<TAB>Closeness<TAB>AverageDistance
+  ofs << "Actor\tComponent\tEccentricity\tCloseness\tAverageDistance\n";
+  for (size_t i = 0; i < sources.size(); ++i) {
+    ofs << network->actorName(sources[i]) << "\t" << analytics.component[sources[i]]
+        << "\t" << analytics.eccentricity[i] << "\t" << analytics.closeness(i) << "\t"
+        << (analytics.reached[i] ? (double) analytics.distanceSum[i] / analytics.reached[i] : 0)
+        << "\n";
+  }
+
+  ofs.close();
+
+  return 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * graphreport.cpp
+ * Author: agent <agent@local>
+ * Date:   October 19, 2026
+ *
+ * This program loads a movie_cast file into the packed
+ * graph & reports how many bytes each actor, edge & movie
+ * takes, next to an estimate for the ActorGraph layout.
+ * An optional scale factor projects the totals for a
+ * larger cast database, which helps with capacity planning.
+ * The number of connected & biconnected components & of
+ * articulation actors is printed as well.
+ */
+
+#include <iostream>
+#include <string>
+#include "PackedGraph.hpp"
+
+int main(int argc, char* argv[]) {
+
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " movie_casts.tsv [scale]" << std::endl;
+    return 1;
+  }
+
+  double scale = (argc > 2) ? std::stod(argv[2]) : 10;
+
+  // Load info from provided filename
+  PackedGraph* network = new PackedGraph();
+  if (!network->loadFromFile(argv[1]))
+    return 1;
+
+  network->reportMemory(std::cout, scale);
+
+  uint32_t articulations = 0;
+  for (uint32_t actor = 0; actor < network->getActorCount(); ++actor)
+    articulations += network->isArticulation(actor);
+
+  std::cout << "components: " << network->getComponentCount()
+            << "\tbiconnected components: " << network->getBiconnectedCount()
+            << "\tarticulation actors: " << articulations << "\n";
+
+  return 0;
+}
@@ -11,30 +11,79 @@
  * the entire path consisting of the common shared movie & the 
  * actor's name. Essentially, this program implements the 
  * Six Degrees of Bacon game.
+ *
+ * Mode "c" answers weighted queries with a contraction
+ * hierarchy, saved next to the movie_cast file (as .ch) the
+ * first time & reused by later runs.
  */
 
  #include <iostream>
  #include <fstream>
  #include <sstream>
  #include "ActorGraph.hpp"
+ #include "PackedGraph.hpp"
+ #include "ContractionHierarchy.hpp"
+ #include "ResultWriter.hpp"
 
  int main(int argc, char* argv[]) {
 
  	// Create an ActorGraph object
  	ActorGraph* network = new ActorGraph();
+  // A window needs both of its years
+  if (argc == 6) {
+    cerr << "Usage: ./pathfinder movie_casts.tsv u|w|c test_pairs.tsv out_paths.tsv [fromYear toYear]\n";
+    return -1;
+  }
   string option = argv[2];
   ifstream ifs(argv[3]);
-  ofstream ofs(argv[4]);
+  // Results are buffered & written by a separate I/O thread
+  ResultWriter ofs(argv[4]);
+  if (!ofs.isOpen()) {
+    cerr << "Failed to open " << argv[4] << "!\n";
+    return -1;
+  }
   bool have_header = false;
 
-  // Print header to output file
-  ofs << "(actor)--[movie#@year]-->(actor)--..." << endl;
+  // Optional window: only use movies released in [fromYear, toYear]
+  int fromYear = (argc > 6) ? stoi(argv[5]) : INT_MIN;
+  int toYear = (argc > 6) ? stoi(argv[6]) : INT_MAX;
+
+  // Hierarchy mode: works on the packed graph instead. The hierarchy is
+  // built over every movie, so windowed runs use Dijkstra
+  bool hierarchy = (option.compare("c") == 0);
+  if (hierarchy && argc > 6) {
+    cerr << "Mode c does not take a window of years, using Dijkstra instead\n";
+    hierarchy = false;
+  }
+  PackedGraph packed;
+  ContractionHierarchy ch(packed);
+  unordered_map<string, ActorNode*> actors;
+  // Reused to format the hierarchy's paths
+  ostringstream line;
 
- 	// Load info from provided filename
- 	auto success = network->loadFromFile(argv[1], false);
-  // Now we need to make ActorEdges for actor connections
-  network->buildActorEdges();
-  auto actors = network->getActorsMap();
+  if (hierarchy) {
+    // Nothing to build a hierarchy from
+    if (!packed.loadFromFile(argv[1]))
+      return -1;
+
+    string chFile = string(argv[1]) + ".ch";
+    if (!ch.load(chFile)) {
+      ch.build();
+      // Still usable for this run, but later runs will rebuild it
+      if (!ch.save(chFile))
+        cerr << "Failed to save " << chFile << ", it will be rebuilt next time!\n";
+    }
+  }
+  else {
+ 	  // Load info from provided filename
+ 	  network->loadFromFile(argv[1], false);
+    // Now we need to make ActorEdges for actor connections
+    network->buildActorEdges();
+    actors = network->getActorsMap();
+  }
+
+  // Print header to output file
+  ofs << "(actor)--[movie#@year]-->(actor)--...\n";
 
   // Read while their is lines to be read
   while(ifs) {
@@ -62,23 +111,54 @@
     string actor1(record[0]);
     string actor2(record[1]);
 
+    if (hierarchy) {
+      // Unknown actors & unconnected pairs leave an empty line
+      uint32_t start = packed.findActor(actor1);
+      uint32_t end = packed.findActor(actor2);
+      vector<uint32_t> path, movies;
+      if (start != PackedGraph::NO_ACTOR && end != PackedGraph::NO_ACTOR &&
+          packed.getComponent(start) == packed.getComponent(end) &&
+          ch.query(start, end, path, movies) != -1) {
+        line.str("");
+        packed.exportPath(path, movies, line);
+        ofs << line.str();
+      }
+      ofs << '\n';
+      continue;
+    }
+
+    // Unknown actors or actors in different components have no path,
+    // which leaves an empty line without running any search
+    if (actors.find(actor1) == actors.end() || actors.find(actor2) == actors.end() ||
+        actors[actor1]->component != actors[actor2]->component) {
+      ofs << '\n';
+      continue;
+    }
+
     /* Find all the paths to an actor from the first actor */
     if (option.compare("u") == 0)   // if unweighted
-      network->BFS(actors[actor1]);
+      network->BFS(actors[actor1], fromYear, toYear);
 
     // If weighted
     else
-      network->Dijkstra(actors[actor1]);
+      network->Dijkstra(actors[actor1], fromYear, toYear);
+
+    // No path using only the movies of the window
+    if (actors[actor2] != actors[actor1] && actors[actor2]->prev == NULL) {
+      ofs << '\n';
+      continue;
+    }
 
     // Export the results to outfile
     network->exportResults(actors[actor1], actors[actor2], ofs);
-    ofs << std::endl; // Add line break
+    ofs << '\n'; // Add line break
   }
 
-  // Close & flush streams.
-  ofs.close();
-  ofs.flush();
+  // Close streams, writing what is left
+  bool written = ofs.close();
   ifs.close();
+  if (!written)
+    return -1;
 
   return 1;
  }
\ No newline at end of file